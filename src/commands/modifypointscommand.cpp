@@ -14,10 +14,12 @@ int ModifyPointsCommand::id() const { return Command::MODIFY_TANGENTS_COMMAND_ID
 void ModifyPointsCommand::swap()
 {
   for (auto& [path, points] : m_data) {
+    std::set<std::size_t> indices;
     for (auto& [point_ptr, other] : points) {
       point_ptr->swap(other);
+      indices.insert(path->point_index(point_ptr));
     }
-    path->on_change(path, Path::POINTS_CHANGED, nullptr, { this });
+    path->on_points_changed(indices, { this });
   }
 }
 
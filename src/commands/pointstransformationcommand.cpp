@@ -54,17 +54,20 @@ PointsTransformationCommand
 void PointsTransformationCommand::redo()
 {
   for (auto&& [path, alternatives] : m_alternative_points) {
-    path->on_change(path, Path::POINTS_CHANGED, nullptr, { this });
     const auto points = path->points_ref();
+    std::set<std::size_t> indices;
     for (const auto& [i, _] : alternatives) {
       points[i]->swap(alternatives[i]);
+      indices.insert(i);
     }
 
     const auto& i_mode_property = path->property(Path::INTERPOLATION_PROPERTY_KEY);
     const auto i_mode = i_mode_property->value<Path::InterpolationMode>();
     for (auto [point, alternative] : path->modified_points(false, i_mode)) {
       point->swap(alternative);
+      indices.insert(path->point_index(point));
     }
+    path->on_points_changed(indices, { this });
   }
 }
 
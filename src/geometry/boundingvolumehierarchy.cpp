@@ -0,0 +1,205 @@
+#include "geometry/boundingvolumehierarchy.h"
+#include <cassert>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <set>
+#include <stack>
+
+namespace
+{
+
+constexpr std::size_t max_leaf_size = 4;
+
+bool intersects(const omm::Rectangle& a, const omm::Rectangle& b)
+{
+  return a.left() <= b.right() && b.left() <= a.right()
+      && a.top() <= b.bottom() && b.top() <= a.bottom();
+}
+
+/**
+ * @brief tests whether the line { origin + t * direction | t_min <= t <= t_max } intersects
+ *  `box` using the slab method.
+ */
+bool intersects(const omm::Rectangle& box, const omm::Vec2f& origin, const omm::Vec2f& direction,
+                double t_min, double t_max)
+{
+  const omm::Vec2f lower = box.top_left();
+  const omm::Vec2f upper = box.bottom_right();
+  for (std::size_t k = 0; k < 2; ++k) {
+    if (direction[k] == 0.0) {
+      if (origin[k] < lower[k] || origin[k] > upper[k]) {
+        return false;
+      }
+    } else {
+      double t0 = (lower[k] - origin[k]) / direction[k];
+      double t1 = (upper[k] - origin[k]) / direction[k];
+      if (t0 > t1) {
+        std::swap(t0, t1);
+      }
+      t_min = std::max(t_min, t0);
+      t_max = std::min(t_max, t1);
+      if (t_min > t_max) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+omm::Rectangle unite(const omm::Rectangle& a, const omm::Rectangle& b)
+{
+  return omm::Rectangle(omm::Vec2f::min(a.top_left(), b.top_left()),
+                        omm::Vec2f::max(a.bottom_right(), b.bottom_right()));
+}
+
+}  // namespace
+
+namespace omm
+{
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(const std::vector<Rectangle>& boxes)
+  : m_boxes(boxes)
+{
+  m_indices.resize(m_boxes.size());
+  m_leaves.resize(m_boxes.size());
+  for (std::size_t i = 0; i < m_indices.size(); ++i) {
+    m_indices[i] = i;
+  }
+  if (!m_boxes.empty()) {
+    m_nodes.reserve(2 * m_boxes.size() / max_leaf_size + 1);
+    build(0, m_boxes.size());
+  }
+}
+
+std::size_t BoundingVolumeHierarchy::build(const std::size_t begin, const std::size_t end)
+{
+  assert(begin < end);
+  const Rectangle box = range_box(begin, end);
+  const std::size_t node_i = m_nodes.size();
+  m_nodes.push_back(Node(box, begin, end));
+  if (end - begin <= max_leaf_size) {
+    for (std::size_t i = begin; i < end; ++i) {
+      m_leaves[m_indices[i]] = node_i;
+    }
+  } else {
+    // split at the median of the box centers along the longer axis.
+    const std::size_t axis = box.width() >= box.height() ? 0 : 1;
+    const auto center = [this, axis](const std::size_t i) {
+      return m_boxes[i].top_left()[axis] + m_boxes[i].bottom_right()[axis];
+    };
+    const std::size_t mid = begin + (end - begin) / 2;
+    std::nth_element(std::next(m_indices.begin(), static_cast<long>(begin)),
+                     std::next(m_indices.begin(), static_cast<long>(mid)),
+                     std::next(m_indices.begin(), static_cast<long>(end)),
+                     [center](const std::size_t a, const std::size_t b) {
+                       return center(a) < center(b);
+                     });
+    const std::size_t left = build(begin, mid);
+    const std::size_t right = build(mid, end);
+    m_nodes[node_i].left = left;
+    m_nodes[node_i].right = right;
+    m_nodes[left].parent = node_i;
+    m_nodes[right].parent = node_i;
+  }
+  return node_i;
+}
+
+Rectangle BoundingVolumeHierarchy::range_box(const std::size_t begin, const std::size_t end) const
+{
+  Rectangle box = m_boxes[m_indices[begin]];
+  for (std::size_t i = begin + 1; i < end; ++i) {
+    box = unite(box, m_boxes[m_indices[i]]);
+  }
+  return box;
+}
+
+void BoundingVolumeHierarchy::refit(const std::map<std::size_t, Rectangle>& boxes)
+{
+  // a node is built before its children, hence the children are refit first if the nodes are
+  // visited in descending order.
+  std::set<std::size_t, std::greater<>> nodes;
+  for (const auto& [i, box] : boxes) {
+    assert(i < m_boxes.size());
+    m_boxes[i] = box;
+    nodes.insert(m_leaves[i]);
+  }
+  while (!nodes.empty()) {
+    const std::size_t node_i = *nodes.begin();
+    nodes.erase(nodes.begin());
+    Node& node = m_nodes[node_i];
+    if (node.is_leaf()) {
+      node.box = range_box(node.begin, node.end);
+    } else {
+      node.box = unite(m_nodes[node.left].box, m_nodes[node.right].box);
+    }
+    if (node_i > 0) {
+      nodes.insert(node.parent);
+    }
+  }
+}
+
+template<typename Predicate>
+std::vector<std::size_t> BoundingVolumeHierarchy::query(const Predicate& predicate) const
+{
+  std::vector<std::size_t> hits;
+  if (m_nodes.empty()) {
+    return hits;
+  }
+
+  std::stack<std::size_t, std::vector<std::size_t>> stack;
+  stack.push(0);
+  while (!stack.empty()) {
+    const Node& node = m_nodes[stack.top()];
+    stack.pop();
+    if (predicate(node.box)) {
+      if (node.is_leaf()) {
+        for (std::size_t i = node.begin; i < node.end; ++i) {
+          if (predicate(m_boxes[m_indices[i]])) {
+            hits.push_back(m_indices[i]);
+          }
+        }
+      } else {
+        stack.push(node.left);
+        stack.push(node.right);
+      }
+    }
+  }
+  std::sort(hits.begin(), hits.end());
+  return hits;
+}
+
+std::vector<std::size_t> BoundingVolumeHierarchy::intersect(const Rectangle& box) const
+{
+  return query([&box](const Rectangle& candidate) { return intersects(box, candidate); });
+}
+
+std::vector<std::size_t> BoundingVolumeHierarchy::intersect_line(const Vec2f& a,
+                                                                 const Vec2f& b) const
+{
+  const Vec2f direction = b - a;
+  return query([&a, &direction](const Rectangle& candidate) {
+    return intersects(candidate, a, direction, 0.0, 1.0);
+  });
+}
+
+std::vector<std::size_t> BoundingVolumeHierarchy::intersect_ray(const Vec2f& origin,
+                                                                const Vec2f& direction) const
+{
+  static constexpr auto infinity = std::numeric_limits<double>::infinity();
+  return query([&origin, &direction](const Rectangle& candidate) {
+    return intersects(candidate, origin, direction, 0.0, infinity);
+  });
+}
+
+std::size_t BoundingVolumeHierarchy::size() const { return m_boxes.size(); }
+
+BoundingVolumeHierarchy::Node::Node(const Rectangle& box, const std::size_t begin,
+                                    const std::size_t end)
+  : box(box), begin(begin), end(end)
+{
+}
+
+bool BoundingVolumeHierarchy::Node::is_leaf() const { return left == right; }
+
+}  // namespace omm
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <map>
+#include <vector>
+#include <cstddef>
+#include "geometry/rectangle.h"
+#include "geometry/vec2.h"
+
+namespace omm
+{
+
+/**
+ * @brief The BoundingVolumeHierarchy class is a binary tree of axis-aligned boxes.
+ *  It answers which of the boxes it was built from intersect a line, a ray or another box
+ *  in O(log n + k) rather than O(n).
+ *  The structure of the tree is fixed when it is built, `refit` adapts it to changed boxes.
+ */
+class BoundingVolumeHierarchy
+{
+public:
+  explicit BoundingVolumeHierarchy(const std::vector<Rectangle>& boxes);
+
+  /**
+   * @brief returns the ascending indices of all boxes that intersect `box`.
+   */
+  std::vector<std::size_t> intersect(const Rectangle& box) const;
+
+  /**
+   * @brief returns the ascending indices of all boxes that intersect the line segment
+   *  from `a` to `b`.
+   */
+  std::vector<std::size_t> intersect_line(const Vec2f& a, const Vec2f& b) const;
+
+  /**
+   * @brief returns the ascending indices of all boxes that intersect the ray which starts at
+   *  `origin` and goes into `direction`.
+   */
+  std::vector<std::size_t> intersect_ray(const Vec2f& origin, const Vec2f& direction) const;
+
+  /**
+   * @brief replaces the boxes with the given indices and refits the nodes above them in
+   *  O(k log n) for k boxes.
+   *  The structure of the tree is kept, hence queries may become slower if the boxes moved far.
+   */
+  void refit(const std::map<std::size_t, Rectangle>& boxes);
+
+  std::size_t size() const;
+
+private:
+  struct Node
+  {
+    explicit Node(const Rectangle& box, const std::size_t begin, const std::size_t end);
+    Rectangle box;
+
+    // range in m_indices. Only leaves have their boxes in that range, inner nodes have children.
+    std::size_t begin;
+    std::size_t end;
+    std::size_t left = 0;
+    std::size_t right = 0;
+    std::size_t parent = 0;
+    bool is_leaf() const;
+  };
+
+  std::vector<Rectangle> m_boxes;
+  std::vector<std::size_t> m_indices;
+  std::vector<Node> m_nodes;
+
+  // the i-th box is in the leaf m_nodes[m_leaves[i]].
+  std::vector<std::size_t> m_leaves;
+
+  // returns the union of m_boxes[m_indices[begin]] .. m_boxes[m_indices[end - 1]].
+  Rectangle range_box(const std::size_t begin, const std::size_t end) const;
+  std::size_t build(const std::size_t begin, const std::size_t end);
+
+  template<typename Predicate> std::vector<std::size_t> query(const Predicate& predicate) const;
+};
+
+}  // namespace omm
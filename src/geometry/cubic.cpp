@@ -9,13 +9,53 @@ namespace
 template<typename T, std::size_t N> T evaluate(const std::array<T, N>& ps, const double t)
 {
   assert(0 <= t && t <= 1.0);
-  omm::Vec2f p(0.0, 0.0);
-  for (std::size_t j = 0; j < N; ++j) {
-    p += ps[std::size_t(N-j-1)] * pow(t, j);
+  T p = ps[0];
+  for (std::size_t j = 1; j < N; ++j) {
+    p = p * t + ps[j];
   }
   return p;
 }
 
+template<std::size_t N>
+std::array<double, N> component(const std::array<omm::Vec2f, N>& vs, const std::size_t k)
+{
+  std::array<double, N> cs;
+  for (std::size_t j = 0; j < N; ++j) {
+    cs[j] = vs[j][k];
+  }
+  return cs;
+}
+
+/**
+ * @brief evaluates the polynomial with coefficients `cs` (highest degree first) at each of the
+ *  `n` parameters in `ts` and writes the results to `out`.
+ *  The iterations are independent of each other such that the loop can be vectorized.
+ */
+template<std::size_t N>
+void evaluate(const std::array<double, N>& cs, const double* ts, const std::size_t n, double* out)
+{
+  for (std::size_t i = 0; i < n; ++i) {
+    const double t = ts[i];
+    double v = cs[0];
+    for (std::size_t j = 1; j < N; ++j) {
+      v = v * t + cs[j];
+    }
+    out[i] = v;
+  }
+}
+
+template<std::size_t N>
+std::pair<std::vector<double>, std::vector<double>>
+evaluate(const std::array<omm::Vec2f, N>& cs, const std::vector<double>& ts)
+{
+  const std::size_t n = ts.size();
+  std::vector<double> xs(n);
+  std::vector<double> ys(n);
+  evaluate(component(cs, 0), ts.data(), n, xs.data());
+  evaluate(component(cs, 1), ts.data(), n, ys.data());
+  return { xs, ys };
+}
+
 template<typename T>
 std::array<T, 4> constexpr bezier_4(const std::array<T, 4>& ps) noexcept
 {
@@ -37,21 +77,106 @@ std::array<T, 3> constexpr bezier_4_derivative(const std::array<T, 4>& ps) noexc
   };
 }
 
+template<typename T>
+std::pair<std::array<T, 4>, std::array<T, 4>> subdivide(const std::array<T, 4>& ps, const double t)
+{
+  const auto lerp = [t](const T& a, const T& b) { return (1.0 - t) * a + t * b; };
+  const T p01 = lerp(ps[0], ps[1]);
+  const T p12 = lerp(ps[1], ps[2]);
+  const T p23 = lerp(ps[2], ps[3]);
+  const T p012 = lerp(p01, p12);
+  const T p123 = lerp(p12, p23);
+  const T p0123 = lerp(p012, p123);
+  return { { ps[0], p01, p012, p0123 }, { p0123, p123, p23, ps[3] } };
+}
+
+double adaptive_length(const std::array<omm::Vec2f, 4>& ps, const double eps, std::size_t depth)
+{
+  // The arc length is bounded by the length of the chord and the length of the control polygon.
+  // Both converge quickly when the segment is subdivided.
+  // See Jens Gravesen, Adaptive subdivision and the length and energy of Bézier curves, 1997.
+  static constexpr std::size_t max_depth = 16;
+  const double chord = (ps[3] - ps[0]).euclidean_norm();
+  double polygon = 0.0;
+  for (std::size_t i = 0; i < 3; ++i) {
+    polygon += (ps[i+1] - ps[i]).euclidean_norm();
+  }
+
+  if (polygon - chord <= eps || depth >= max_depth) {
+    return (chord + polygon) / 2.0;
+  } else {
+    const auto [left, right] = subdivide(ps, 0.5);
+    return adaptive_length(left, eps / 2.0, depth + 1)
+         + adaptive_length(right, eps / 2.0, depth + 1);
+  }
+}
+
+double distance_to_chord(const omm::Vec2f& p, const omm::Vec2f& a, const omm::Vec2f& b)
+{
+  const omm::Vec2f d = b - a;
+  const double norm = d.euclidean_norm();
+  if (norm < 10e-10) {
+    return (p - a).euclidean_norm();
+  } else {
+    return std::abs(d.x * (p.y - a.y) - d.y * (p.x - a.x)) / norm;
+  }
+}
+
+/**
+ * @brief returns the real roots of `c[0] * t^2 + c[1] * t + c[2]`.
+ */
+std::vector<double> find_quadratic_roots(const std::array<double, 3>& c)
+{
+  static constexpr double eps = 10e-12;
+  if (std::abs(c[0]) < eps) {
+    if (std::abs(c[1]) < eps) {
+      return {};
+    } else {
+      return { -c[2] / c[1] };
+    }
+  }
+
+  const double discriminant = c[1] * c[1] - 4.0 * c[0] * c[2];
+  if (discriminant < 0.0) {
+    return {};
+  } else {
+    // avoid cancellation, see Numerical Recipes, 5.6
+    const double q = -0.5 * (c[1] + std::copysign(std::sqrt(discriminant), c[1]));
+    if (q == 0.0) {
+      return { 0.0 };
+    } else {
+      return { q / c[0], c[2] / q };
+    }
+  }
+}
+
+void flatten(const std::array<omm::Vec2f, 4>& ps, const double tolerance, std::size_t depth,
+             std::vector<omm::Vec2f>& vertices)
+{
+  static constexpr std::size_t max_depth = 16;
+  const bool is_flat = std::max(distance_to_chord(ps[1], ps[0], ps[3]),
+                                distance_to_chord(ps[2], ps[0], ps[3])) <= tolerance;
+  if (is_flat || depth >= max_depth) {
+    vertices.push_back(ps[3]);
+  } else {
+    const auto [left, right] = subdivide(ps, 0.5);
+    flatten(left, tolerance, depth + 1, vertices);
+    flatten(right, tolerance, depth + 1, vertices);
+  }
+}
+
 }  // namespace
 
 namespace omm
 {
 
 Cubic::Cubic(const Point& start, const Point& end)
-  : Cubic( { start.position, start.right_position(),
-             end.left_position(), end.position },
-             start.is_selected && end.is_selected )
+  : Cubic( { start.position, start.right_position(), end.left_position(), end.position } )
 {
 }
 
-Cubic::Cubic(const std::array<Vec2f, 4>& points, const bool is_selected)
+Cubic::Cubic(const std::array<Vec2f, 4>& points)
   : m_points(points)
-  , m_is_selected(is_selected)
 { }
 
 Vec2f Cubic::pos(const double t) const
@@ -64,26 +189,31 @@ Vec2f Cubic::tangent(const double t) const
   return -1.0/6.0 * ::evaluate(bezier_4_derivative(m_points), t);
 }
 
+std::vector<Vec2f> Cubic::pos(const std::vector<double>& ts) const
+{
+  const auto [xs, ys] = ::evaluate(bezier_4(m_points), ts);
+  std::vector<Vec2f> positions;
+  positions.reserve(ts.size());
+  for (std::size_t i = 0; i < ts.size(); ++i) {
+    positions.push_back(Vec2f(xs[i], ys[i]));
+  }
+  return positions;
+}
+
 std::vector<Vec2f> Cubic::interpolate(const std::size_t n) const
 {
   assert(n >= 2);
-  std::vector<Vec2f> points;
-  points.reserve(n);
+  std::vector<double> ts(n);
   for (std::size_t i = 0; i < n; ++i) {
-    points.push_back(pos(double(i)/double(n-1)));
+    ts[i] = double(i)/double(n-1);
   }
-  return points;
+  return pos(ts);
 }
 
-double Cubic::length() const
+double Cubic::length(const double eps) const
 {
-  constexpr std::size_t n = 10;
-  const auto points = interpolate(n);
-  double length = 0.0;
-  for (std::size_t i = 0; i < n - 1; ++i) {
-    length += (points[i] - points[i+1]).euclidean_norm();
-  }
-  return length;
+  assert(eps > 0.0);
+  return adaptive_length(m_points, eps, 0);
 }
 
 Point Cubic::evaluate(const double t) const
@@ -92,6 +222,20 @@ Point Cubic::evaluate(const double t) const
   return Point(pos(t), PolarCoordinates(tangent), PolarCoordinates(-tangent));
 }
 
+std::vector<Point> Cubic::evaluate(const std::vector<double>& ts) const
+{
+  const auto [xs, ys] = ::evaluate(bezier_4(m_points), ts);
+  const auto [dxs, dys] = ::evaluate(bezier_4_derivative(m_points), ts);
+  std::vector<Point> points;
+  points.reserve(ts.size());
+  for (std::size_t i = 0; i < ts.size(); ++i) {
+    const Vec2f tangent = -1.0/6.0 * Vec2f(dxs[i], dys[i]);
+    points.push_back(Point(Vec2f(xs[i], ys[i]), PolarCoordinates(tangent),
+                           PolarCoordinates(-tangent)));
+  }
+  return points;
+}
+
 std::vector<double> Cubic::cut(const Vec2f& start, const Vec2f& end) const
 {
   if ((start - end).euclidean_norm() < 10e-10) {
@@ -126,6 +270,53 @@ std::vector<double> Cubic::cut(const Vec2f& start, const Vec2f& end) const
   return ts_v;
 }
 
-bool Cubic::is_selected() const { return m_is_selected; }
+std::vector<Vec2f> Cubic::flatten(const double tolerance) const
+{
+  std::vector<Vec2f> vertices { m_points[0] };
+  flatten(tolerance, vertices);
+  return vertices;
+}
+
+void Cubic::flatten(const double tolerance, std::vector<Vec2f>& vertices) const
+{
+  assert(tolerance > 0.0);
+  ::flatten(m_points, tolerance, 0, vertices);
+}
+
+Rectangle Cubic::control_point_hull() const
+{
+  Vec2f lower = m_points[0];
+  Vec2f upper = m_points[0];
+  for (std::size_t i = 1; i < m_points.size(); ++i) {
+    lower = Vec2f::min(lower, m_points[i]);
+    upper = Vec2f::max(upper, m_points[i]);
+  }
+  return Rectangle(lower, upper);
+}
+
+Rectangle Cubic::bounding_box() const
+{
+  Vec2f lower = Vec2f::min(m_points[0], m_points[3]);
+  Vec2f upper = Vec2f::max(m_points[0], m_points[3]);
+  const auto coefficients = bezier_4(m_points);
+  const auto derivative = bezier_4_derivative(m_points);
+  for (std::size_t k = 0; k < 2; ++k) {
+    const auto is_inside = [&lower, &upper, k](const Vec2f& p) {
+      return lower[k] <= p[k] && p[k] <= upper[k];
+    };
+    if (is_inside(m_points[1]) && is_inside(m_points[2])) {
+      continue;  // the segment cannot leave the hull of its control points.
+    }
+    const auto cs = component(coefficients, k);
+    for (const double t : find_quadratic_roots(component(derivative, k))) {
+      if (t > 0.0 && t < 1.0) {
+        const double v = ::evaluate(cs, t);
+        lower[k] = std::min(lower[k], v);
+        upper[k] = std::max(upper[k], v);
+      }
+    }
+  }
+  return Rectangle(lower, upper);
+}
 
 }  // namespace omm
@@ -3,6 +3,7 @@
 #include <array>
 #include <cassert>
 #include "geometry/point.h"
+#include "geometry/rectangle.h"
 #include "geometry/vec2.h"
 
 namespace omm
@@ -12,19 +13,58 @@ class Cubic
 {
 public:
   Cubic(const Point& start, const Point& end);
-  Cubic(const std::array<Vec2f, 4>& points, const bool is_selected = false);
+  Cubic(const std::array<Vec2f, 4>& points);
 
   Vec2f pos(const double t) const;
   Vec2f tangent(const double t) const;
-  double length() const;
+
+  /**
+   * @brief computes the arc length of the segment.
+   * @param eps the maximal absolute error of the result.
+   *  The segment is subdivided adaptively until the difference between the length of its control
+   *  polygon and its chord does not exceed `eps`.
+   */
+  double length(const double eps = DEFAULT_LENGTH_ERROR) const;
+  static constexpr auto DEFAULT_LENGTH_ERROR = 0.01;
   Point evaluate(const double t) const;
+
+  /**
+   * @brief evaluates the segment at all parameters `ts` at once.
+   *  This is much faster than calling `pos(double)` or `evaluate(double)` repeatedly.
+   */
+  std::vector<Vec2f> pos(const std::vector<double>& ts) const;
+  std::vector<Point> evaluate(const std::vector<double>& ts) const;
   std::vector<Vec2f> interpolate(const std::size_t n) const;
   std::vector<double> cut(const Vec2f& a, const Vec2f& b) const;
-  bool is_selected() const;
+
+  /**
+   * @brief returns the smallest axis-aligned rectangle which contains all four control points.
+   *  The segment is guaranteed to be inside that rectangle.
+   */
+  Rectangle control_point_hull() const;
+
+  /**
+   * @brief returns the smallest axis-aligned rectangle which contains the segment.
+   *  The extrema are found at the roots of the derivative of each coordinate.
+   */
+  Rectangle bounding_box() const;
+
+  /**
+   * @brief approximates the segment with a polyline.
+   *  The segment is subdivided adaptively until the distance of the inner control points to the
+   *  chord does not exceed `tolerance`.
+   * @return the vertices of the polyline, including start and end of the segment.
+   */
+  std::vector<Vec2f> flatten(const double tolerance) const;
+
+  /**
+   * @brief appends the vertices of the polyline except the start of the segment to `vertices`.
+   *  This allows to flatten subsequent segments into one buffer.
+   */
+  void flatten(const double tolerance, std::vector<Vec2f>& vertices) const;
 
 private:
-  const std::array<Vec2f, 4> m_points;
-  const bool m_is_selected;
+  std::array<Vec2f, 4> m_points;
 };
 
 std::vector<double> find_cubic_roots(const std::array<double, 4>& coefficients) noexcept;
@@ -1,7 +1,7 @@
 #include "geometry/cubics.h"
 #include "geometry/util.h"
 #include "common.h"
-#include <numeric>
+#include <iterator>
 
 namespace
 {
@@ -21,15 +21,147 @@ std::vector<omm::Cubic> make_cubics(const std::vector<omm::Point>& points, const
   return std::vector(cubics.begin(), cubics.end());
 }
 
+omm::Rectangle unite(const omm::Rectangle& a, const omm::Rectangle& b)
+{
+  return omm::Rectangle(omm::Vec2f::min(a.top_left(), b.top_left()),
+                        omm::Vec2f::max(a.bottom_right(), b.bottom_right()));
+}
+
+std::vector<omm::Rectangle> make_bounding_box_tree(const std::vector<omm::Cubic>& cubics)
+{
+  const std::size_t n = cubics.size();
+  std::vector<omm::Rectangle> tree(2 * n, omm::Rectangle(omm::Vec2f::o(), omm::Vec2f::o()));
+  for (std::size_t i = 0; i < n; ++i) {
+    tree[n + i] = cubics[i].bounding_box();
+  }
+  for (std::size_t j = n - 1; n > 0 && j > 0; --j) {
+    tree[j] = unite(tree[2 * j], tree[2 * j + 1]);
+  }
+  return tree;
+}
+
+omm::BoundingBox make_bounding_box(const std::vector<omm::Point>& points,
+                                   const std::vector<omm::Rectangle>& bounding_box_tree)
+{
+  if (bounding_box_tree.empty()) {
+    return omm::BoundingBox(points);
+  } else {
+    const omm::Rectangle& root = bounding_box_tree[1];
+    return omm::BoundingBox({ root.top_left(), root.bottom_right() });
+  }
+}
+
 }  // namespace
 
 namespace omm
 {
 
-Cubics::Cubics(const std::vector<Point>& points, const bool is_closed)
-  : m_cubics(make_cubics(points, is_closed)), m_bounding_box(points), m_is_closed(is_closed)
-  , m_path(to_path(points, is_closed))
+Cubics::Cubics(const std::vector<Point>& points, const bool is_closed, const double length_error)
+  : m_n_points(points.size()), m_cubics(make_cubics(points, is_closed))
+  , m_bounding_box_tree(make_bounding_box_tree(m_cubics))
+  , m_bounding_box(make_bounding_box(points, m_bounding_box_tree))
+  , m_is_closed(is_closed)
+  , m_path(to_path(points, is_closed)), m_length_error(length_error)
+{
+}
+
+void Cubics::update(const std::vector<Point>& points, const std::set<std::size_t>& point_indices)
+{
+  if (points.size() != m_n_points) {
+    *this = Cubics(points, m_is_closed, m_length_error);
+    return;
+  }
+
+  // segment i goes from point i to point i+1, the closing segment from the last to the first point.
+  const std::size_t n_segments = m_cubics.size();
+  std::set<std::size_t> segment_indices;
+  for (const std::size_t i : point_indices) {
+    assert(i < m_n_points);
+    if (i < n_segments) {
+      segment_indices.insert(i);
+    }
+    if (i > 0 && i - 1 < n_segments) {
+      segment_indices.insert(i - 1);
+    } else if (i == 0 && m_is_closed && n_segments == m_n_points) {
+      segment_indices.insert(n_segments - 1);
+    }
+  }
+  if (segment_indices.empty()) {
+    return;
+  }
+
+  // QPainterPath::cubicTo drops degenerate segments, the elements can only be patched if it did not.
+  const bool can_patch_path = m_path.elementCount() == static_cast<int>(1 + 3 * n_segments);
+  for (const std::size_t i : segment_indices) {
+    const Point& start = points[i];
+    const Point& end = points[(i + 1) % m_n_points];
+    m_cubics[i] = Cubic(start, end);
+    if (can_patch_path) {
+      const auto set_element = [this](const std::size_t e, const Vec2f& pos) {
+        m_path.setElementPositionAt(static_cast<int>(e), pos.x, pos.y);
+      };
+      if (i == 0) {
+        set_element(0, start.position);
+      }
+      set_element(1 + 3 * i, start.right_position());
+      set_element(2 + 3 * i, end.left_position());
+      set_element(3 + 3 * i, end.position);
+    }
+  }
+
+  if (!can_patch_path) {
+    m_path = to_path(points, m_is_closed);
+  }
+  update_bounding_box(segment_indices);
+  update_lengths(segment_indices);
+  if (m_bvh) {
+    if (m_bvh.use_count() > 1) {
+      m_bvh = std::make_shared<BoundingVolumeHierarchy>(*m_bvh);
+    }
+    std::map<std::size_t, Rectangle> hulls;
+    for (const std::size_t i : segment_indices) {
+      hulls.emplace(i, m_cubics[i].control_point_hull());
+    }
+    m_bvh->refit(hulls);
+  }
+
+  // the polyline depends on all segments, see `flattening`.
+  m_polygon.reset();
+  m_flattenings.clear();
+}
+
+void Cubics::update_bounding_box(const std::set<std::size_t>& segment_indices)
+{
+  const std::size_t n = m_cubics.size();
+  for (const std::size_t i : segment_indices) {
+    m_bounding_box_tree[n + i] = m_cubics[i].bounding_box();
+  }
+  for (const std::size_t i : segment_indices) {
+    // the ancestors which are shared with the other segments are united more than once.
+    for (std::size_t j = (n + i) / 2; j > 0; j /= 2) {
+      m_bounding_box_tree[j] = unite(m_bounding_box_tree[2 * j], m_bounding_box_tree[2 * j + 1]);
+    }
+  }
+  const Rectangle& root = m_bounding_box_tree[1];
+  m_bounding_box = BoundingBox({ root.top_left(), root.bottom_right() });
+}
+
+void Cubics::update_lengths(const std::set<std::size_t>& segment_indices)
 {
+  if (m_length_tree.empty()) {
+    return;
+  }
+
+  const std::size_t n_leaves = m_length_tree.size() / 2;
+  for (const std::size_t i : segment_indices) {
+    m_lengths[i] = m_cubics[i].length(m_length_error);
+    m_length_tree[n_leaves + i] = m_lengths[i];
+  }
+  for (const std::size_t i : segment_indices) {
+    for (std::size_t j = (n_leaves + i) / 2; j > 0; j /= 2) {
+      m_length_tree[j] = m_length_tree[2 * j] + m_length_tree[2 * j + 1];
+    }
+  }
 }
 
 Point Cubics::evaluate(const double path_t) const
@@ -42,10 +174,38 @@ Point Cubics::evaluate(const double path_t) const
   }
 }
 
+std::vector<Point> Cubics::evaluate(const std::vector<double>& path_ts) const
+{
+  if (m_cubics.empty()) {
+    return std::vector<Point>(path_ts.size());
+  }
+
+  std::vector<Point> points;
+  points.reserve(path_ts.size());
+  std::vector<double> segment_ts;
+  std::size_t current_segment_i = 0;
+  const auto flush = [this, &points, &segment_ts, &current_segment_i]() {
+    const auto segment_points = segment(current_segment_i).evaluate(segment_ts);
+    points.insert(points.end(), segment_points.begin(), segment_points.end());
+    segment_ts.clear();
+  };
+
+  for (const double path_t : path_ts) {
+    const auto [segment_i, segment_t] = path_to_segment(path_t);
+    if (segment_i != current_segment_i && !segment_ts.empty()) {
+      flush();
+    }
+    current_segment_i = segment_i;
+    segment_ts.push_back(segment_t);
+  }
+  flush();
+  return points;
+}
+
 std::vector<double> Cubics::cut(const Vec2f& a, const Vec2f& b) const
 {
   std::list<double> ts;
-  for (std::size_t segment_i = 0; segment_i < m_cubics.size(); ++segment_i) {
+  for (const std::size_t segment_i : bvh().intersect_line(a, b)) {
     for (const double segment_t : m_cubics[segment_i].cut(a, b)) {
       ts.push_back(segment_to_path(segment_i, segment_t));
     }
@@ -61,21 +221,31 @@ std::pair<std::size_t, double> Cubics::path_to_segment(const double path_t) cons
 
   assert(path_t >= 0.0 && path_t <= 1.0);
 
-  double segment_t_start = 0.0;
-  double segment_t_end = lengths()[0];
-  std::size_t segment_i = 0;
-  const double dist = path_t * length();
-  for (segment_i = 0; segment_i < m_cubics.size()-1 && segment_t_end < dist; ++segment_i) {
-    segment_t_start = segment_t_end;
-    segment_t_end += lengths()[segment_i+1];
+  double dist = path_t * length();
+
+  // find the first segment which ends at or after `dist`, `dist` becomes the remaining distance.
+  const std::size_t n_leaves = m_length_tree.size() / 2;
+  std::size_t j = 1;
+  while (j < n_leaves) {
+    if (m_length_tree[2 * j] >= dist) {
+      j = 2 * j;
+    } else {
+      dist -= m_length_tree[2 * j];
+      j = 2 * j + 1;
+    }
+  }
+  if (j - n_leaves >= m_cubics.size()) {
+    // `dist` exceeds the summed lengths due to rounding.
+    return std::pair(m_cubics.size() - 1, 1.0);
   }
+  const std::size_t segment_i = j - n_leaves;
 
-  const double segment_length = lengths()[segment_i];
+  const double segment_length = m_lengths[segment_i];
   static constexpr auto eps = 0.0000001;
   if (segment_length < eps) {
     return std::pair(segment_i, 0.0);
   } else {
-    const double segment_t = (dist - segment_t_start) / segment_length;
+    const double segment_t = dist / segment_length;
     assert(!std::isnan(segment_t));
     return std::pair(segment_i, std::clamp(segment_t, 0.0, 1.0));
   }
@@ -83,35 +253,159 @@ std::pair<std::size_t, double> Cubics::path_to_segment(const double path_t) cons
 
 double Cubics::segment_to_path(const std::size_t& segment_i, const double& segment_t) const
 {
-  double path_t = 0.0;
-  for (std::size_t i = 0; i < segment_i; ++i) {
-    path_t += lengths()[i];
-  }
-  path_t += segment_t * lengths()[segment_i];
+  const double path_t = cumulative_length(segment_i) + segment_t * lengths()[segment_i];
   return path_t / length();
 }
 
-std::vector<double> Cubics::lengths() const
+void Cubics::compute_lengths() const
 {
-  if (m_lengths.empty()) {
-    m_lengths = ::transform<double>(m_cubics, std::mem_fn(&Cubic::length));
+  m_lengths = ::transform<double>(m_cubics, [eps=m_length_error](const Cubic& cubic) {
+    return cubic.length(eps);
+  });
+  std::size_t n_leaves = 1;
+  while (n_leaves < m_lengths.size()) {
+    n_leaves *= 2;
+  }
+  m_length_tree.assign(2 * n_leaves, 0.0);
+  std::copy(m_lengths.begin(), m_lengths.end(), std::next(m_length_tree.begin(), n_leaves));
+  for (std::size_t j = n_leaves - 1; j > 0; --j) {
+    m_length_tree[j] = m_length_tree[2 * j] + m_length_tree[2 * j + 1];
   }
+}
 
+const std::vector<double>& Cubics::lengths() const
+{
+  if (m_length_tree.empty()) {
+    compute_lengths();
+  }
   return m_lengths;
 }
 
+double Cubics::cumulative_length(const std::size_t segment_i) const
+{
+  assert(segment_i <= m_cubics.size());
+  if (m_length_tree.empty()) {
+    compute_lengths();
+  }
+  if (segment_i == m_cubics.size()) {
+    return m_length_tree[1];
+  }
+
+  // sum up the left siblings of the leaf and of its ancestors.
+  const std::size_t n_leaves = m_length_tree.size() / 2;
+  double sum = 0.0;
+  for (std::size_t j = n_leaves + segment_i; j > 1; j /= 2) {
+    if (j % 2 == 1) {
+      sum += m_length_tree[j - 1];
+    }
+  }
+  return sum;
+}
+
 double Cubics::length() const
 {
-  const auto lengths = this->lengths();
-  return std::accumulate(m_lengths.begin(), m_lengths.end(), 0.0);
+  if (m_length_tree.empty()) {
+    compute_lengths();
+  }
+  return m_length_tree[1];
 }
 
 std::size_t Cubics::n_segments() const { return m_cubics.size(); }
 const Cubic& Cubics::segment(const std::size_t& segment_i) const { return m_cubics[segment_i]; }
 
-bool Cubics::contains(const Vec2f &pos) const
+bool Cubics::contains(const Vec2f &pos, const FillRule fill_rule) const
+{
+  return polygon().contains(pos, fill_rule);
+}
+
+std::vector<bool> Cubics::contains(const std::vector<Vec2f>& positions,
+                                   const FillRule fill_rule) const
 {
-  return m_path.contains(to_qpoint(pos));
+  const Polygon& polygon = this->polygon();
+  std::vector<bool> contains(positions.size());
+  for (std::size_t i = 0; i < positions.size(); ++i) {
+    contains[i] = polygon.contains(positions[i], fill_rule);
+  }
+  return contains;
+}
+
+const Polygon& Cubics::polygon() const
+{
+  if (!m_polygon) {
+    const double diagonal = (m_bounding_box.bottom_right() - m_bounding_box.top_left())
+                            .euclidean_norm();
+    // a path without extent is flattened to a single vertex with any tolerance.
+    const double tolerance = diagonal > 0.0 ? RELATIVE_FLATTEN_TOLERANCE * diagonal : 1.0;
+    m_polygon = std::make_shared<const Polygon>(flattened(tolerance));
+  }
+  return *m_polygon;
+}
+
+const QPainterPath& Cubics::painter_path() const { return m_path; }
+
+const std::vector<Vec2f>& Cubics::flattened(const double tolerance) const
+{
+  return flattening(tolerance).vertices;
+}
+
+const QPainterPath& Cubics::painter_path(const double tolerance) const
+{
+  // Drawing the polyline only pays off if it has considerably fewer vertices than the path has
+  // control points, i.e., if the segments are only a few `tolerance`s long.
+  static constexpr double max_segment_length = 16.0;
+  if (tolerance <= 0.0 || m_cubics.empty()
+      || length() > max_segment_length * tolerance * static_cast<double>(m_cubics.size())) {
+    return m_path;
+  } else {
+    return flattening(tolerance).painter_path;
+  }
+}
+
+const Cubics::Flattening& Cubics::flattening(const double tolerance) const
+{
+  assert(tolerance > 0.0);
+
+  // the bucket tolerance does not exceed `tolerance`.
+  const int exponent = static_cast<int>(std::floor(std::log2(tolerance)));
+  auto& flattening = m_flattenings[exponent];
+  if (!flattening) {
+    // half of the tolerance is spent on flattening, the other half on dropping vertices.
+    const double bucket_tolerance = std::ldexp(1.0, exponent) / 2.0;
+    std::vector<Vec2f> vertices;
+    if (!m_cubics.empty()) {
+      vertices.push_back(m_cubics.front().pos(0.0));
+      for (const Cubic& cubic : m_cubics) {
+        cubic.flatten(bucket_tolerance, vertices);
+      }
+    }
+
+    auto f = std::make_shared<Flattening>();
+    for (std::size_t i = 0; i < vertices.size(); ++i) {
+      const bool is_last = i + 1 == vertices.size();
+      if (f->vertices.empty() || is_last
+          || (vertices[i] - f->vertices.back()).euclidean_norm() > bucket_tolerance) {
+        f->vertices.push_back(vertices[i]);
+      }
+    }
+    if (!f->vertices.empty()) {
+      f->painter_path.moveTo(to_qpoint(f->vertices.front()));
+      for (std::size_t i = 1; i < f->vertices.size(); ++i) {
+        f->painter_path.lineTo(to_qpoint(f->vertices[i]));
+      }
+    }
+    flattening = f;
+  }
+  return *flattening;
+}
+const BoundingBox& Cubics::bounding_box() const { return m_bounding_box; }
+
+const BoundingVolumeHierarchy& Cubics::bvh() const
+{
+  if (!m_bvh) {
+    const auto hulls = ::transform<Rectangle>(m_cubics, std::mem_fn(&Cubic::control_point_hull));
+    m_bvh = std::make_shared<BoundingVolumeHierarchy>(hulls);
+  }
+  return *m_bvh;
 }
 
 std::vector<double> find_cubic_roots(const std::array<double, 4>& coefficients) noexcept
@@ -1,14 +1,19 @@
 #pragma once
 
+#include <map>
+#include <set>
 #include <vector>
 #include "geometry/point.h"
 #include <utility>
 #include "geometry/cubic.h"
 #include "geometry/vec2.h"
 #include "geometry/boundingbox.h"
+#include "geometry/boundingvolumehierarchy.h"
+#include "geometry/polygon.h"
 #include <cstddef>
 #include <QPainterPath>
 #include <random>
+#include <memory>
 #include "logging.h"
 
 namespace omm
@@ -17,24 +22,128 @@ namespace omm
 class Cubics
 {
 public:
-  Cubics(const std::vector<Point>& points, const bool is_closed);
+  /**
+   * @param length_error the maximal absolute error of the length of each segment.
+   *  See Cubic::length.
+   */
+  Cubics(const std::vector<Point>& points, const bool is_closed,
+         const double length_error = Cubic::DEFAULT_LENGTH_ERROR);
+
+  /**
+   * @brief updates the path after the points with indices `point_indices` have changed.
+   *  `points` are all points of the path, their number must not have changed.
+   *  Only the adjacent segments, their lengths, their bounding boxes and their elements in the
+   *  painter path are recomputed. The bounding box, the arc length table and the hierarchy are
+   *  updated in O(k log n) for k changed segments. The flattened paths and the polygon are
+   *  rebuilt on next use.
+   */
+  void update(const std::vector<Point>& points, const std::set<std::size_t>& point_indices);
   double length() const;
   double distance(double t);
+
+  /**
+   * @brief finds the segment and the segment-local parameter for `path_t`.
+   *  The arc length table is descended in O(log n).
+   */
   std::pair<std::size_t, double> path_to_segment(const double path_t) const;
   double segment_to_path(const std::size_t& segment_i, const double& segment_t) const;
   Point evaluate(const double path_t) const;
+
+  /**
+   * @brief evaluates the path at all parameters `path_ts` at once.
+   *  Subsequent parameters that fall into the same segment are evaluated in one batch, hence
+   *  sorted parameters yield best performance.
+   */
+  std::vector<Point> evaluate(const std::vector<double>& path_ts) const;
   std::vector<double> cut(const Vec2f& a, const Vec2f& b) const;
-  std::vector<double> lengths() const;
+  const std::vector<double>& lengths() const;
+
+  /**
+   * @brief returns the length of the path from its start to the start of the `segment_i`-th
+   *  segment in O(log n). `cumulative_length(n_segments())` is `length()`.
+   */
+  double cumulative_length(const std::size_t segment_i) const;
   std::size_t n_segments() const;
   const Cubic& segment(const std::size_t& segment_i) const;
-  bool contains(const Vec2f& pos) const;
+  using FillRule = Polygon::FillRule;
+  bool contains(const Vec2f& pos, const FillRule fill_rule = FillRule::OddEven) const;
+  std::vector<bool> contains(const std::vector<Vec2f>& positions,
+                             const FillRule fill_rule = FillRule::OddEven) const;
+
+  /**
+   * @brief returns the flattened path which is used for point-in-path queries.
+   *  The polygon is implicitly closed, even if the path is open.
+   *  It deviates at most `RELATIVE_FLATTEN_TOLERANCE` times the diagonal of the bounding box from
+   *  the path, hence the precision does not depend on the size of the path.
+   *  It is built on first use.
+   */
+  const Polygon& polygon() const;
+  static constexpr auto RELATIVE_FLATTEN_TOLERANCE = 0.0001;
+  const QPainterPath& painter_path() const;
+
+  /**
+   * @brief approximates the path with a polyline which deviates at most `tolerance` from it.
+   *  Vertices which are very close to their predecessor are dropped, hence the number of vertices
+   *  is proportional to the length of the path in units of `tolerance` rather than to the number
+   *  of segments.
+   *  The result is cached per power-of-two bucket of `tolerance`.
+   */
+  const std::vector<Vec2f>& flattened(const double tolerance) const;
+
+  /**
+   * @brief returns the painter path to draw the path with the level of detail `tolerance`.
+   *  If the segments are short compared to `tolerance`, that is the flattened polyline.
+   *  Otherwise, or if `tolerance` is zero, that is the exact `painter_path()`.
+   */
+  const QPainterPath& painter_path(const double tolerance) const;
+
+  /**
+   * @brief returns a hierarchy of the control point hulls of the segments.
+   *  The i-th box in the hierarchy belongs to the i-th segment.
+   *  It is built on first use.
+   */
+  const BoundingVolumeHierarchy& bvh() const;
+
+  /**
+   * @brief returns the smallest axis-aligned box which contains the path.
+   *  Unlike `BoundingBox(points)`, the box does not contain the tangent handles.
+   */
+  const BoundingBox& bounding_box() const;
 
 private:
-  const std::vector<Cubic> m_cubics;
-  const BoundingBox m_bounding_box;
-  const bool m_is_closed;
-  const QPainterPath m_path;
+  std::size_t m_n_points;
+  std::vector<Cubic> m_cubics;
+
+  // the box of the i-th segment is at n_segments() + i, the inner node j unites the nodes 2j and
+  // 2j + 1. Hence, the root at 1 contains all segments.
+  std::vector<Rectangle> m_bounding_box_tree;
+  BoundingBox m_bounding_box;
+  void update_bounding_box(const std::set<std::size_t>& segment_indices);
+  bool m_is_closed;
+  QPainterPath m_path;
+  double m_length_error;
   mutable std::vector<double> m_lengths;
+
+  // the tree has a power-of-two number of leaves, the length of the i-th segment is at
+  // m_length_tree.size() / 2 + i and the inner node j is the sum of the nodes 2j and 2j + 1.
+  // It is empty until the lengths are needed.
+  mutable std::vector<double> m_length_tree;
+  void compute_lengths() const;
+  void update_lengths(const std::set<std::size_t>& segment_indices);
+
+  // shared with copies, hence it is copied before it is refit.
+  mutable std::shared_ptr<BoundingVolumeHierarchy> m_bvh;
+  mutable std::shared_ptr<const Polygon> m_polygon;
+
+  struct Flattening
+  {
+    std::vector<Vec2f> vertices;
+    QPainterPath painter_path;
+  };
+
+  // maps the exponent of the tolerance bucket to the flattened path.
+  mutable std::map<int, std::shared_ptr<const Flattening>> m_flattenings;
+  const Flattening& flattening(const double tolerance) const;
 };
 
 }  // namespace omm
@@ -4,47 +4,105 @@
 
 #include "geometry/objecttransformation.h"
 
+namespace
+{
+
+/**
+ * @brief applies the 2x3 matrix `affine` to `n` vectors.
+ *  `w` is the homogeneous coordinate, i.e., 1.0 for positions and 0.0 for directions.
+ *  The iterations are independent of each other such that the loop can be vectorized.
+ */
+void apply_affine(const std::array<double, 6>& affine, const double w,
+                  const omm::Vec2f* in, const std::size_t n, omm::Vec2f* out)
+{
+  const double a = affine[0], b = affine[1], tx = affine[2] * w;
+  const double c = affine[3], d = affine[4], ty = affine[5] * w;
+  for (std::size_t i = 0; i < n; ++i) {
+    const double x = in[i].x;
+    const double y = in[i].y;
+    out[i].x = a * x + b * y + tx;
+    out[i].y = c * x + d * y + ty;
+  }
+}
+
+}  // namespace
+
 namespace omm
 {
 
 ObjectTransformation::ObjectTransformation()
-  : m_translation(0, 0), m_scaling(1, 1), m_shearing(0), m_rotation(0) { }
+  : m_translation(0, 0), m_scaling(1, 1), m_shearing(0), m_rotation(0)
+  , m_affine({ 1.0, 0.0, 0.0, 0.0, 1.0, 0.0 })
+{
+}
 
 ObjectTransformation::ObjectTransformation( const Vec2f& translation, const Vec2f& scale,
                                             const double rotation, const double shear )
-  : m_translation(translation), m_scaling(scale), m_shearing(shear), m_rotation(rotation) { }
+  : m_translation(translation), m_scaling(scale), m_shearing(shear), m_rotation(rotation)
+{
+  update_affine();
+}
 
 ObjectTransformation::ObjectTransformation(const Matrix& mat) { set_mat(mat); }
 
 void ObjectTransformation::set_translation(const Vec2f& translation_vector)
 {
   m_translation = translation_vector;
+  update_affine();
 }
 
 void ObjectTransformation::set_rotation(const double& angle)
 {
   m_rotation = angle;
+  update_affine();
 }
 
-void ObjectTransformation::set_shearing(const double& shear) { m_shearing = shear; }
+void ObjectTransformation::set_shearing(const double& shear)
+{
+  m_shearing = shear;
+  update_affine();
+}
 
 void ObjectTransformation::set_scaling(const Vec2f& scale_vector)
 {
   m_scaling = scale_vector;
+  update_affine();
 }
 
 void ObjectTransformation::translate(const Vec2f& translation_vector)
 {
   m_translation += translation_vector;
+  update_affine();
 }
 
-void ObjectTransformation::rotate(const double& angle) { m_rotation += angle; }
-void ObjectTransformation::shear(const double& shear) { m_shearing += shear; }
+void ObjectTransformation::rotate(const double& angle)
+{
+  m_rotation += angle;
+  update_affine();
+}
+
+void ObjectTransformation::shear(const double& shear)
+{
+  m_shearing += shear;
+  update_affine();
+}
 
 void ObjectTransformation::scale(const Vec2f& scale_vector)
 {
   m_scaling.x *= scale_vector.x;
   m_scaling.y *= scale_vector.y;
+  update_affine();
+}
+
+void ObjectTransformation::update_affine()
+{
+  // translation * rotation * scaling * shearing, see `to_mat`.
+  const double cos = std::cos(m_rotation);
+  const double sin = std::sin(m_rotation);
+  m_affine = { cos * m_scaling.x - sin * m_scaling.y * m_shearing, -sin * m_scaling.y,
+               m_translation.x,
+               sin * m_scaling.x + cos * m_scaling.y * m_shearing,  cos * m_scaling.y,
+               m_translation.y };
 }
 
 ObjectTransformation ObjectTransformation::translated(const Vec2f& translation_vector) const
@@ -77,20 +135,10 @@ ObjectTransformation ObjectTransformation::scaled(const Vec2f& scale_vector) con
 
 Matrix ObjectTransformation::to_mat() const
 {
-  const Matrix translation({ { 1, 0, m_translation.x },
-                             { 0, 1, m_translation.y },
-                             { 0, 0, 1                } });
-  const Matrix rotation({ { std::cos(m_rotation), -std::sin(m_rotation), 0 },
-                          { std::sin(m_rotation),  std::cos(m_rotation), 0 },
-                          { 0,                0,               1 } });
-  const Matrix scaling({ { m_scaling.x, 0,              0 },
-                         { 0,              m_scaling.y, 0 },
-                         { 0,              0,           1 } });
-  const Matrix shearing({ { 1,          0, 0 },
-                          { m_shearing, 1, 0 },
-                          { 0,          0, 1 } });
-
-  return translation * rotation * scaling * shearing;
+  // translation * rotation * scaling * shearing
+  return Matrix({ { m_affine[0], m_affine[1], m_affine[2] },
+                  { m_affine[3], m_affine[4], m_affine[5] },
+                  { 0.0,         0.0,         1.0         } });
 }
 
 void ObjectTransformation::set_mat(const Matrix& mat)
@@ -122,6 +170,12 @@ void ObjectTransformation::set_mat(const Matrix& mat)
   m_rotation = -atan2(b, d);
   m_scaling = Vec2f((a*d - b*c) / n, n);
   m_shearing = (a*b + c*d) / pow(n, 2.0);
+  if (n > 0.0) {
+    // the decomposition is exact, hence the matrix can be taken as is.
+    m_affine = { a, b, m_translation.x, c, d, m_translation.y };
+  } else {
+    update_affine();  // propagate the NaNs of the decomposition.
+  }
 }
 
 Vec2f ObjectTransformation::translation() const { return m_translation; }
@@ -175,12 +229,56 @@ bool operator<(const ObjectTransformation& lhs, const ObjectTransformation& rhs)
 
 Vec2f ObjectTransformation::apply_to_position(const Vec2f& position) const
 {
-  return to_mat().apply_to_position(position);
+  Vec2f result;
+  apply_affine(m_affine, 1.0, &position, 1, &result);
+  return result;
 }
 
 Vec2f ObjectTransformation::apply_to_direction(const Vec2f& direction) const
 {
-  return to_mat().apply_to_direction(direction);
+  Vec2f result;
+  apply_affine(m_affine, 0.0, &direction, 1, &result);
+  return result;
+}
+
+std::vector<Vec2f>
+ObjectTransformation::apply_to_position(const std::vector<Vec2f>& positions) const
+{
+  std::vector<Vec2f> result(positions.size());
+  apply_affine(m_affine, 1.0, positions.data(), positions.size(), result.data());
+  return result;
+}
+
+std::vector<Vec2f>
+ObjectTransformation::apply_to_direction(const std::vector<Vec2f>& directions) const
+{
+  std::vector<Vec2f> result(directions.size());
+  apply_affine(m_affine, 0.0, directions.data(), directions.size(), result.data());
+  return result;
+}
+
+std::vector<Point> ObjectTransformation::apply(const std::vector<Point>& points) const
+{
+  const std::size_t n = points.size();
+  std::vector<Vec2f> positions(n);
+  std::vector<Vec2f> left_tangents(n);
+  std::vector<Vec2f> right_tangents(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    positions[i] = points[i].position;
+    left_tangents[i] = points[i].left_tangent.to_cartesian();
+    right_tangents[i] = points[i].right_tangent.to_cartesian();
+  }
+  apply_affine(m_affine, 1.0, positions.data(), n, positions.data());
+  apply_affine(m_affine, 0.0, left_tangents.data(), n, left_tangents.data());
+  apply_affine(m_affine, 0.0, right_tangents.data(), n, right_tangents.data());
+
+  std::vector<Point> result;
+  result.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    result.push_back(Point(positions[i], PolarCoordinates(left_tangents[i]),
+                           PolarCoordinates(right_tangents[i])));
+  }
+  return result;
 }
 
 BoundingBox ObjectTransformation::apply(const BoundingBox& bb) const
@@ -5,6 +5,7 @@
 #include "geometry/point.h"
 #include "geometry/boundingbox.h"
 #include "geometry/matrix.h"
+#include <array>
 #include <Qt>
 
 namespace omm
@@ -53,6 +54,15 @@ public:
   BoundingBox apply(const BoundingBox& bb) const;
   ObjectTransformation apply(const ObjectTransformation& t) const;
   Point apply(const Point& point) const;
+
+  /**
+   * @brief the batch variants transform many items at once.
+   *  They are much faster than transforming the items one by one.
+   */
+  std::vector<Vec2f> apply_to_position(const std::vector<Vec2f>& positions) const;
+  std::vector<Vec2f> apply_to_direction(const std::vector<Vec2f>& directions) const;
+  std::vector<Point> apply(const std::vector<Point>& points) const;
+
   ObjectTransformation normalized() const;
   bool contains_nan() const;
 
@@ -63,6 +73,14 @@ private:
   Vec2f m_scaling;
   double m_shearing;
   double m_rotation;
+
+  /**
+   * @brief the first two rows of `to_mat()`, row-major.
+   *  It is kept in sync with the decomposition above, hence applying the transformation does not
+   *  need to evaluate any trigonometric function.
+   */
+  std::array<double, 6> m_affine;
+  void update_affine();
 };
 
 std::ostream& operator<<(std::ostream& ostream, const ObjectTransformation& t);
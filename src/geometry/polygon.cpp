@@ -0,0 +1,121 @@
+#include "geometry/polygon.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace
+{
+
+double cross(const omm::Vec2f& a, const omm::Vec2f& b) { return a.x * b.y - a.y * b.x; }
+
+}  // namespace
+
+namespace omm
+{
+
+Polygon::Polygon(const std::vector<Vec2f>& vertices)
+  : m_vertices(vertices)
+{
+  if (m_vertices.size() < 3) {
+    return;
+  }
+
+  m_lower = m_vertices.front();
+  m_upper = m_vertices.front();
+  for (const Vec2f& v : m_vertices) {
+    m_lower = Vec2f::min(m_lower, v);
+    m_upper = Vec2f::max(m_upper, v);
+  }
+
+  // an edge is listed in every band it overlaps. The number of bands is chosen such that an
+  // edge overlaps MAX_BANDS_PER_EDGE bands on average, hence outlines with many tall edges
+  // (e.g., combs or stars) get few bands rather than quadratic memory.
+  const std::size_t n_edges = m_vertices.size();
+  double total_extent = 0.0;
+  for (std::size_t i = 0; i < n_edges; ++i) {
+    total_extent += std::abs(m_vertices[(i+1) % n_edges].y - m_vertices[i].y);
+  }
+  const double height = m_upper.y - m_lower.y;
+  const double n_bands = total_extent > 0.0
+                         ? MAX_BANDS_PER_EDGE * static_cast<double>(n_edges) * height / total_extent
+                         : 1.0;
+  m_n_bands = static_cast<std::size_t>(std::clamp(n_bands, 1.0, static_cast<double>(
+                                                    std::min(n_edges, MAX_BANDS))));
+  m_band_height = height / static_cast<double>(m_n_bands);
+
+  // counting sort of the edges into the bands they overlap.
+  std::vector<std::size_t> counts(m_n_bands + 1, 0);
+  for (std::size_t i = 0; i < n_edges; ++i) {
+    const auto [first, last] = bands(m_vertices[i].y, m_vertices[(i+1) % n_edges].y);
+    for (std::size_t band = first; band <= last; ++band) {
+      counts[band + 1] += 1;
+    }
+  }
+  for (std::size_t band = 0; band < m_n_bands; ++band) {
+    counts[band + 1] += counts[band];
+  }
+  m_band_offsets = counts;
+  m_band_edges.resize(m_band_offsets.back());
+  for (std::size_t i = 0; i < n_edges; ++i) {
+    const auto [first, last] = bands(m_vertices[i].y, m_vertices[(i+1) % n_edges].y);
+    for (std::size_t band = first; band <= last; ++band) {
+      m_band_edges[counts[band]] = i;
+      counts[band] += 1;
+    }
+  }
+}
+
+std::pair<std::size_t, std::size_t> Polygon::bands(const double y0, const double y1) const
+{
+  const auto band = [this](const double y) -> std::size_t {
+    if (m_band_height <= 0.0) {
+      return 0;
+    } else {
+      const double i = std::floor((y - m_lower.y) / m_band_height);
+      return static_cast<std::size_t>(std::clamp(i, 0.0, static_cast<double>(m_n_bands - 1)));
+    }
+  };
+  const std::size_t a = band(y0);
+  const std::size_t b = band(y1);
+  return { std::min(a, b), std::max(a, b) };
+}
+
+int Polygon::winding_number(const Vec2f& pos) const
+{
+  if (m_n_bands == 0 || pos.y < m_lower.y || pos.y > m_upper.y || pos.x > m_upper.x) {
+    return 0;
+  }
+
+  // count the signed crossings of the ray from `pos` towards +x.
+  const std::size_t band = bands(pos.y, pos.y).first;
+  const std::size_t n = m_vertices.size();
+  int winding_number = 0;
+  for (std::size_t k = m_band_offsets[band]; k < m_band_offsets[band + 1]; ++k) {
+    const std::size_t i = m_band_edges[k];
+    const Vec2f& a = m_vertices[i];
+    const Vec2f& b = m_vertices[(i+1) % n];
+    if (a.y <= pos.y) {
+      if (b.y > pos.y && cross(b - a, pos - a) > 0.0) {
+        winding_number += 1;
+      }
+    } else if (b.y <= pos.y && cross(b - a, pos - a) < 0.0) {
+      winding_number -= 1;
+    }
+  }
+  return winding_number;
+}
+
+bool Polygon::contains(const Vec2f& pos, const FillRule fill_rule) const
+{
+  const int winding_number = this->winding_number(pos);
+  switch (fill_rule) {
+  case FillRule::OddEven: return winding_number % 2 != 0;
+  case FillRule::NonZero: return winding_number != 0;
+  }
+  assert(false);
+  return false;
+}
+
+const std::vector<Vec2f>& Polygon::vertices() const { return m_vertices; }
+
+}  // namespace omm
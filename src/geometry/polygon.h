@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include "geometry/vec2.h"
+
+namespace omm
+{
+
+/**
+ * @brief The Polygon class answers point-in-polygon queries.
+ *  The polygon is implicitly closed, i.e., there is an edge from the last to the first vertex.
+ *  The edges are sorted into horizontal bands such that a query only needs to look at the few
+ *  edges which overlap the band of the query point.
+ *  The polygon is immutable, it must be rebuilt if the vertices change.
+ */
+class Polygon
+{
+public:
+  enum class FillRule { OddEven, NonZero };
+  explicit Polygon(const std::vector<Vec2f>& vertices);
+
+  /**
+   * @brief returns the winding number of the polygon around `pos`.
+   */
+  int winding_number(const Vec2f& pos) const;
+  bool contains(const Vec2f& pos, const FillRule fill_rule = FillRule::OddEven) const;
+  const std::vector<Vec2f>& vertices() const;
+
+private:
+  std::vector<Vec2f> m_vertices;
+  Vec2f m_lower;
+  Vec2f m_upper;
+  double m_band_height = 0.0;
+  std::size_t m_n_bands = 0;
+
+  // m_band_edges[m_band_offsets[i]] .. m_band_edges[m_band_offsets[i+1]] are the edges that
+  // overlap the i-th band. Edge i goes from vertex i to vertex i+1 (or 0).
+  std::vector<std::size_t> m_band_offsets;
+  std::vector<std::size_t> m_band_edges;
+  std::pair<std::size_t, std::size_t> bands(const double y0, const double y1) const;
+
+  static constexpr std::size_t MAX_BANDS = 1 << 16;
+
+  // the average number of bands an edge overlaps, i.e., m_band_edges holds about
+  // (MAX_BANDS_PER_EDGE + 1) entries per edge.
+  static constexpr double MAX_BANDS_PER_EDGE = 4.0;
+};
+
+}  // namespace omm
@@ -123,9 +123,11 @@ void subdivide(Application& app)
 
   for (auto* path : Object::cast<Path>(app.scene.item_selection<Object>())) {
     std::list<Path::PointSequence> sequences;
-    const auto cubics = path->cubics();
+    const auto& cubics = path->cubics();
+    const auto points = path->points();
     for (std::size_t i = 0; i < cubics.n_segments(); ++i) {
-      if (cubics.segment(i).is_selected()) {
+      // the selection is a property of the points, the segments are geometry only.
+      if (points[i].is_selected && points[(i+1) % points.size()].is_selected) {
         Path::PointSequence sequence(i+1);
         for (std::size_t j = 0; j < n; ++j) {
           sequence.sequence.push_back(cubics.segment(i).evaluate((j+1.0)/(n+1.0)));
@@ -4,6 +4,8 @@
 #include <QMessageBox>
 #include <QFileDialog>
 #include <QApplication>
+#include <QSettings>
+#include <thread>
 
 #include "keybindings/defaultkeysequenceparser.h"
 #include "mainwindow/mainwindow.h"
@@ -40,6 +42,10 @@ Application::Application(QApplication& app)
   } else {
     LFATAL("Resetting application instance.");
   }
+
+  const bool is_multi_core = std::thread::hardware_concurrency() > 1;
+  scene.set_parallel_evaluation(QSettings().value(PARALLEL_EVALUATION_SETTINGS_KEY,
+                                                  is_multi_core).toBool());
 }
 
 Application& Application::instance()
@@ -44,6 +44,12 @@ public:
   enum class InsertionMode { Default, AsParent, AsChild };
   void insert_object(const std::string& key, InsertionMode mode);
 
+  /**
+   * @brief whether independent objects are updated concurrently, see
+   *  `Scene::set_parallel_evaluation`. It defaults to true if there is more than one core.
+   */
+  static constexpr auto PARALLEL_EVALUATION_SETTINGS_KEY = "scene/parallel_evaluation";
+
 private:
   QApplication& m_app;
   static Application* m_instance;
@@ -156,7 +156,7 @@ void ExportDialog::render(QPaintDevice& device, double scale) const
 
     m_scene.object_tree.root().set_transformation(get_transformation());
 
-    m_scene.evaluate_tags();
+    m_scene.update();
     renderer.render();
   }
 
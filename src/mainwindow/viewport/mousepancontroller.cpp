@@ -52,4 +52,9 @@ Vec2f MousePanController::update(const Vec2f& current_cursor_position)
   return delta;
 }
 
+bool MousePanController::is_moving() const
+{
+  return m_action != Action::None && m_was_applied;
+}
+
 }  // namespace omm
@@ -20,6 +20,11 @@ public:
   Vec2f apply(const Vec2f& current_cursor_position, ObjectTransformation& t);
   Vec2f update(const Vec2f& current_cursor_position);
 
+  /**
+   * @brief returns true while a pan or zoom gesture changes the viewport transformation.
+   */
+  bool is_moving() const;
+
 private:
   Vec2f m_last_position;
   Vec2f m_global_start_position;
@@ -1,8 +1,11 @@
 #include "mainwindow/viewport/viewport.h"
 
+#include <QElapsedTimer>
 #include <QPainter>
+#include <QRegion>
 #include <QTimer>
 #include <QMouseEvent>
+#include <QSettings>
 
 #include "scene/scene.h"
 #include "python/pythonengine.h"
@@ -27,45 +30,153 @@ Viewport::Viewport(Scene& scene)
   , m_timer(std::make_unique<QTimer>())
   , m_pan_controller([this](const Vec2f& pos) { set_cursor_position(*this, pos); })
   , m_renderer(scene, Painter::Category::Handles | Painter::Category::Objects)
+  , m_raster_cache(std::size_t(QSettings().value(RASTER_CACHE_BUDGET_SETTINGS_KEY,
+                                                 DEFAULT_RASTER_CACHE_BUDGET).toInt()) << 20)
 {
+  m_renderer.device_tolerance = DEVICE_TOLERANCE;
+  m_renderer.raster_cache = &m_raster_cache;
+  m_renderer.async_image_decoding = true;
+  m_scene.image_cache.on_loaded = [this](const std::string& filename) {
+    m_scene.on_image_loaded(filename);
+    m_image_damage |= m_renderer.take_placeholder_region(filename);
+    update();
+  };
+  m_timer->setSingleShot(true);
+  m_timer->setInterval(GESTURE_IDLE_INTERVAL);
+  connect(m_timer.get(), &QTimer::timeout, [this]() {
+    m_frame_is_valid = false;
+    update();
+  });
   setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
   setFocusPolicy(Qt::StrongFocus);
 
   setMouseTracking(true);
   connect(&scene, SIGNAL(scene_changed(AbstractPropertyOwner*, int, Property*)),
           this, SLOT(update()));
+  connect(&scene, &Scene::scene_changed, [this]() { m_frame_is_valid = false; });
 
   connect(&scene, SIGNAL(selection_changed(std::set<AbstractPropertyOwner*>)),
           this, SLOT(update()));
 }
 
+Viewport::~Viewport()
+{
+  m_scene.image_cache.on_loaded = nullptr;
+}
+
 #if USE_OPENGL
 void Viewport::paintGL()
 #else
 void Viewport::paintEvent(QPaintEvent*)
 #endif
 {
-  QPainter painter(this);
-  m_renderer.painter = &painter;
+  {
+    QSignalBlocker blocker(&m_scene);
+    m_scene.object_tree.root().set_transformation(viewport_transformation());
+  }
 
+  // while panning or zooming, the last frame is transformed rather than the scene re-rendered.
+  const bool reuse_frame = m_pan_controller.is_moving() && m_frame_is_valid
+                           && m_frame.size() == size() * devicePixelRatioF();
+  if (reuse_frame) {
+    m_timer->start();
+  } else {
+    render_frame();
+  }
+
+  QPainter painter(this);
   painter.setRenderHint(QPainter::Antialiasing);
   painter.setRenderHint(QPainter::SmoothPixmapTransform);
-  painter.fillRect(rect(), Qt::gray);
-
-  m_scene.object_tree.root().set_transformation(viewport_transformation());
-  {
-    QSignalBlocker blocker(&m_scene);
-    m_scene.evaluate_tags();
+  if (reuse_frame) {
+    painter.fillRect(rect(), Qt::gray);
+    const auto t = viewport_transformation().apply(m_frame_transformation.inverted());
+    painter.setTransform(Painter::to_qtransform(t), false);
   }
-  m_scene.update();
+  painter.drawPixmap(0, 0, m_frame);
+  painter.resetTransform();
+
+  // handles and the tool are not part of the frame, they change often and are cheap to draw.
+  m_renderer.painter = &painter;
+  m_renderer.category_filter = Painter::Category::Handles;
   m_renderer.render();
 
+  // tools draw objects (e.g., the path which is being created) and handles.
+  m_renderer.category_filter = Painter::Category::Objects | Painter::Category::Handles;
   auto& tool = m_scene.tool_box.active_tool();
   tool.viewport_transformation = viewport_transformation();
   tool.draw(m_renderer);
   m_renderer.painter = nullptr;
 }
 
+void Viewport::render_frame()
+{
+  const bool is_slow = frame_time(Quality::Full) > FRAME_TIME_BUDGET;
+  const Quality quality = m_is_interacting && is_slow ? Quality::Draft : Quality::Full;
+  QElapsedTimer timer;
+  timer.start();
+
+  {
+    QSignalBlocker blocker(&m_scene);
+    m_scene.update();
+  }
+
+  // only the damaged regions of the last frame are rendered if possible.
+  const auto damage = m_scene.take_damage();
+  const double pixel_ratio = devicePixelRatioF();
+  const bool is_partial = damage.has_value() && quality == m_frame_quality
+                          && m_frame.size() == size() * pixel_ratio
+                          && m_frame_transformation == viewport_transformation();
+  QRegion region = rect();
+  if (is_partial) {
+    const QTransform transformation = Painter::to_qtransform(m_frame_transformation);
+    region = QRegion();
+    for (const QRectF& damaged_rect : *damage) {
+      const QRectF device_rect = transformation.mapRect(damaged_rect) & QRectF(rect());
+      region |= device_rect.toAlignedRect().adjusted(-DAMAGE_MARGIN, -DAMAGE_MARGIN,
+                                                      DAMAGE_MARGIN, DAMAGE_MARGIN);
+    }
+    region |= m_image_damage;
+    region &= rect();
+  } else {
+    m_frame = QPixmap(size() * pixel_ratio);
+    m_frame.setDevicePixelRatio(pixel_ratio);
+  }
+  m_image_damage = QRegion();
+  m_frame_transformation = viewport_transformation();
+  m_frame_quality = quality;
+  m_frame_is_valid = true;
+
+  if (!region.isEmpty()) {
+    QPainter painter(&m_frame);
+    painter.setClipRegion(region);
+    painter.fillRect(region.boundingRect(), Qt::gray);
+    painter.setRenderHint(QPainter::Antialiasing, quality == Quality::Full);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, quality == Quality::Full);
+
+    m_renderer.painter = &painter;
+    m_renderer.viewport_rect = region.boundingRect();
+    m_renderer.draft_quality = quality == Quality::Draft;
+    m_renderer.device_tolerance = quality == Quality::Draft ? DRAFT_DEVICE_TOLERANCE
+                                                            : DEVICE_TOLERANCE;
+    m_renderer.category_filter = Painter::Category::Objects;
+    m_renderer.render();
+    m_renderer.painter = nullptr;
+  }
+
+  double& frame_time = m_frame_times[static_cast<std::size_t>(quality)];
+  const double elapsed = static_cast<double>(timer.nsecsElapsed()) / 1e6;
+  if (frame_time == 0.0) {
+    frame_time = elapsed;
+  } else {
+    frame_time += FRAME_TIME_SMOOTHING * (elapsed - frame_time);
+  }
+}
+
+double Viewport::frame_time(const Quality quality) const
+{
+  return m_frame_times[static_cast<std::size_t>(quality)];
+}
+
 void Viewport::mousePressEvent(QMouseEvent* event)
 {
   const Vec2f cursor_pos = Vec2f(event->pos());
@@ -83,7 +194,10 @@ void Viewport::mousePressEvent(QMouseEvent* event)
   if (event->modifiers() & Qt::AltModifier) {
     event->accept();
   } else {
-    if (m_scene.tool_box.active_tool().mouse_press(cursor_pos, *event)) { event->accept(); }
+    if (m_scene.tool_box.active_tool().mouse_press(cursor_pos, *event)) {
+      m_is_interacting = true;
+      event->accept();
+    }
   }
   update();
 }
@@ -113,6 +227,7 @@ void Viewport::mouseMoveEvent(QMouseEvent* event)
 
 void Viewport::mouseReleaseEvent(QMouseEvent* event)
 {
+  m_is_interacting = false;
   if (!m_pan_controller.end_move()) {
     const auto cursor_pos = Vec2f(event->pos());
     m_scene.tool_box.active_tool().mouse_release(cursor_pos, *event);
@@ -131,6 +246,7 @@ ObjectTransformation Viewport::viewport_transformation() const
 }
 
 Scene& Viewport::scene() const { return m_scene; }
+std::size_t Viewport::n_culled_objects() const { return m_renderer.n_culled_objects; }
 void Viewport::reset() { m_viewport_transformation = ObjectTransformation(); }
 
 void Viewport::set_transformation(const ObjectTransformation& transformation)
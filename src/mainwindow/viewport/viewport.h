@@ -1,11 +1,14 @@
 #pragma once
 
+#include <array>
 #include <memory>
+#include <QPixmap>
 #include <QTimer>
 
 #include "geometry/objecttransformation.h"
 #include "mainwindow/viewport/mousepancontroller.h"
 #include "renderers/painter.h"
+#include "renderers/rastercache.h"
 #include "scene/scene.h"
 
 #define USE_OPENGL 0
@@ -32,13 +35,30 @@ class Viewport : public ViewportBase
   Q_OBJECT
 public:
   Viewport(Scene& scene);
-  ~Viewport() = default;
+  ~Viewport();
   Scene& scene() const;
   void reset();
   void set_transformation(const ObjectTransformation& transformation);
 
   ObjectTransformation viewport_transformation() const;
 
+  /**
+   * @brief returns the number of objects which were outside the viewport in the last frame.
+   */
+  std::size_t n_culled_objects() const;
+
+  /**
+   * @brief Draft quality is used during tool interactions if rendering a frame in full quality
+   *  takes longer than `FRAME_TIME_BUDGET`.
+   */
+  enum class Quality { Draft = 0, Full = 1 };
+
+  /**
+   * @brief returns the moving average of the time (in ms) it takes to render a frame in the
+   *  given quality. Returns 0 if no frame has been rendered in that quality yet.
+   */
+  double frame_time(const Quality quality) const;
+
 protected:
 #if USE_OPENGL
   void paintGL() override;
@@ -51,11 +71,48 @@ protected:
   void keyPressEvent(QKeyEvent* event) override;
 
 private:
+  /**
+   * @brief evaluates the scene and renders it into `m_frame`.
+   */
+  void render_frame();
+
   Scene& m_scene;
   std::unique_ptr<QTimer> m_timer;
   ObjectTransformation m_viewport_transformation;
   MousePanController m_pan_controller;
   Painter m_renderer;
+  RasterCache m_raster_cache;
+
+  // the last rendered frame, which is transformed and reused during pan and zoom gestures.
+  QPixmap m_frame;
+  ObjectTransformation m_frame_transformation;
+  bool m_frame_is_valid = false;
+
+  // the regions of the frame which show placeholders of images which have been decoded since.
+  QRegion m_image_damage;
+
+  // a full-quality frame is rendered if a gesture pauses for that long (in ms).
+  static constexpr int GESTURE_IDLE_INTERVAL = 100;
+
+  // true while a tool handles a mouse drag.
+  bool m_is_interacting = false;
+  std::array<double, 2> m_frame_times = { 0.0, 0.0 };
+  static constexpr double FRAME_TIME_BUDGET = 1000.0 / 60.0;
+
+  // the weight of the latest frame in the moving average of the frame times.
+  static constexpr double FRAME_TIME_SMOOTHING = 0.2;
+  static constexpr double DRAFT_DEVICE_TOLERANCE = 1.0;
+  Quality m_frame_quality = Quality::Full;
+
+  // damaged regions are extended by that many pixels to cover anti-aliasing and cosmetic pens.
+  static constexpr int DAMAGE_MARGIN = 2;
+
+  // the memory budget of the raster cache in MiB.
+  static constexpr auto RASTER_CACHE_BUDGET_SETTINGS_KEY = "viewport/raster_cache_budget";
+  static constexpr int DEFAULT_RASTER_CACHE_BUDGET = 256;
+
+  // curves are drawn with that maximal deviation in pixels, see Painter::device_tolerance.
+  static constexpr double DEVICE_TOLERANCE = 0.25;
 };
 
 }  // namespace omm
@@ -3,7 +3,6 @@
 #include "properties/floatproperty.h"
 #include "objects/path.h"
 #include "common.h"
-#include "geometry/cubics.h"
 
 namespace omm
 {
@@ -12,9 +11,10 @@ class Style;
 
 void AbstractProceduralPath::draw_object(Painter &renderer, const Style& style) const
 {
-  if (QPainter* painter = renderer.painter; painter != nullptr && is_active()) {
+  if (is_active()) {
     renderer.set_style(style);
-    painter->drawPath(m_painter_path);
+    cubics();  // makes sure that m_cubics exists.
+    renderer.draw_path(m_cubics);
   }
 }
 
@@ -36,25 +36,38 @@ std::unique_ptr<Object> AbstractProceduralPath::convert() const
 
 Point AbstractProceduralPath::evaluate(const double t) const
 {
-  return Cubics(m_points, is_closed()).evaluate(t);
+  return cubics().evaluate(t);
+}
+
+std::vector<Point> AbstractProceduralPath::evaluate(const std::vector<double>& ts) const
+{
+  return cubics().evaluate(ts);
+}
+
+BoundingBox AbstractProceduralPath::bounding_box() const
+{
+  return cubics().bounding_box();
 }
 
-BoundingBox AbstractProceduralPath::bounding_box() const { return BoundingBox(m_points); }
 double AbstractProceduralPath::path_length() const
 {
-  return Cubics(m_points, is_closed()).length();
+  return cubics().length();
 }
 
 bool AbstractProceduralPath::contains(const Vec2f &pos) const
 {
-  return Cubics(m_points, is_closed()).contains(pos);
+  return cubics().contains(pos);
+}
+
+std::vector<bool> AbstractProceduralPath::contains(const std::vector<Vec2f>& positions) const
+{
+  return cubics().contains(positions);
 }
 
 std::vector<double> AbstractProceduralPath::cut(const Vec2f& c_start, const Vec2f& c_end)
 {
   const auto gti = global_transformation().inverted();
-  return Cubics(m_points, is_closed()).cut( gti.apply_to_position(c_start),
-                                            gti.apply_to_position(c_end) );
+  return cubics().cut(gti.apply_to_position(c_start), gti.apply_to_position(c_end));
 }
 
 Object::PathUniquePtr AbstractProceduralPath::outline(const double t) const
@@ -67,9 +80,25 @@ Object::PathUniquePtr AbstractProceduralPath::outline(const double t) const
 
 void AbstractProceduralPath::update()
 {
-  m_points = points();
-  m_painter_path = Painter::path(m_points, is_closed());
+  auto points = this->points();
+  const bool is_closed = this->is_closed();
+  if (points != m_points || is_closed != m_is_closed) {
+    m_points = std::move(points);
+    m_is_closed = is_closed;
+    m_geometry_revision += 1;
+    m_cubics.reset();
+  }
 }
 
+const Cubics& AbstractProceduralPath::cubics() const
+{
+  if (!m_cubics) {
+    m_cubics = std::make_shared<const Cubics>(m_points, m_is_closed);
+  }
+  return *m_cubics;
+}
+
+std::size_t AbstractProceduralPath::geometry_revision() const { return m_geometry_revision; }
+
 
 }  // namespace omm
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "objects/object.h"
+#include "geometry/cubics.h"
 #include <Qt>
 
 namespace omm
@@ -18,18 +19,33 @@ public:
   Flag flags() const override;
 
   Point evaluate(const double t) const override;
+  std::vector<Point> evaluate(const std::vector<double>& ts) const override;
   double path_length() const override;
   bool contains(const Vec2f &pos) const override;
+  std::vector<bool> contains(const std::vector<Vec2f>& positions) const override;
 
   std::vector<double> cut(const Vec2f& c_start, const Vec2f& c_end);
   PathUniquePtr outline(const double t) const override;
 
   void update() override;
-protected:
+
+  /**
+   * @brief returns the segments of this path.
+   *  The result is cached until the geometry changes, i.e., until geometry_revision() changes.
+   */
+  const Cubics& cubics() const;
+
+  /**
+   * @brief the geometry revision is incremented whenever `update` yields different points or a
+   *  different closed-flag.
+   */
+  std::size_t geometry_revision() const;
 
 private:
   std::vector<Point> m_points;
-  QPainterPath m_painter_path;
+  bool m_is_closed = false;
+  std::size_t m_geometry_revision = 0;
+  mutable std::shared_ptr<const Cubics> m_cubics;
 };
 
 }  // namespace omm
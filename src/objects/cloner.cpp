@@ -28,6 +28,14 @@ copy.set("scale", np.random.random(2)+0.5)
 
 constexpr auto max = std::numeric_limits<int>::max();
 
+void set_oriented_position(omm::ObjectTransformation& transformation, const omm::Point& op,
+                           const bool align)
+{
+  // the instances have no parent, i.e., their global transformation is their local one.
+  if (align) { transformation.set_rotation(op.rotation()); }
+  transformation.set_translation(op.position);
+}
+
 }  // namespace
 
 namespace omm
@@ -131,6 +139,17 @@ void Cloner::draw_object(Painter &renderer, const Style& style) const
   if (draw_in_global_space) {
     renderer.push_transformation(global_transformation(true).inverted());
   }
+
+  // the subtree of each child is recorded once and drawn for each of its instances.
+  std::vector<DisplayList> display_lists(m_instances.empty() ? 0 : n_children());
+  for (std::size_t i = 0; i < display_lists.size(); ++i) {
+    tree_child(i).append_display_lists(display_lists[i], QTransform(), style);
+  }
+  for (const Instance& instance : m_instances) {
+    renderer.push_transformation(instance.transformation);
+    renderer.draw_display_list(display_lists[instance.child]);
+    renderer.pop_transformation();
+  }
   for (auto&& clone : m_clones) {
     clone->draw_recursive(renderer, style);
   }
@@ -142,6 +161,9 @@ void Cloner::draw_object(Painter &renderer, const Style& style) const
 BoundingBox Cloner::bounding_box() const
 {
   BoundingBox bb;
+  for (const Instance& instance : m_instances) {
+    bb |= instance.transformation.apply(tree_child(instance.child).bounding_box());
+  }
   for (auto&& clone : m_clones) {
     bb |= clone->transformation().apply(clone->bounding_box());
   }
@@ -152,6 +174,12 @@ Cloner::Mode Cloner::mode() const { return property(MODE_PROPERTY_KEY)->value<Mo
 
 bool Cloner::contains(const Vec2f &pos) const
 {
+  for (const Instance& instance : m_instances) {
+    const Object& child = tree_child(instance.child);
+    if (child.contains(instance.transformation.apply_to_position(pos))) {
+      return true;
+    }
+  }
   for (auto&& clone : m_clones) {
     if (clone->contains(clone->transformation().apply_to_position(pos))) {
       return true;
@@ -162,21 +190,35 @@ bool Cloner::contains(const Vec2f &pos) const
 
 void Cloner::update()
 {
-  auto* apo = property(PATH_REFERENCE_PROPERTY_KEY)->value<AbstractPropertyOwner*>();
-  auto* ref = kind_cast<Object*>(apo);
-  if (ref) {ref->update(); }
-
-  if (is_active()) {
-    if (m_clones.size() == 0) {
-      m_clones = make_clones();
-      m_draw_children = false;
-    }
-  } else {
+  // the path has been updated before, see DependencyGraph.
+  if (!is_active()) {
+    m_instances.clear();
     m_clones.clear();
     m_draw_children = true;
+  } else if (mode() == Mode::Script) {
+    m_instances.clear();
+    m_clones = make_clones();
+    m_draw_children = false;
+  } else {
+    // the structure (i.e., which child is instantiated how often) changes rarely, the layout
+    // changes, e.g., while a distance slider is dragged.
+    update_instance_structure();
+    update_instance_layout();
+    m_clones.clear();
+    m_draw_children = false;
   }
 }
 
+bool Cloner::is_update_thread_safe() const
+{
+  // the other modes run Python code or evaluate the referenced path, which computes its
+  // geometry lazily.
+  const Mode mode = this->mode();
+  return mode == Mode::Linear || mode == Mode::Grid || mode == Mode::Radial;
+}
+
+bool Cloner::draws_descendants() const { return true; }
+
 void Cloner::on_change(AbstractPropertyOwner *subject, int code, Property *property,
                        std::set<const void *> trace)
 {
@@ -188,6 +230,7 @@ void Cloner::on_property_value_changed(Property &property, std::set<const void *
 {
   Object::on_property_value_changed(property, trace);
   if (::contains(m_clone_dependencies, &property)) {
+    // the instances are updated in place, see `update`.
     m_clones.clear();
   }
 }
@@ -205,52 +248,91 @@ std::unique_ptr<Object> Cloner::convert() const
   copy_properties(*converted);
   copy_tags(*converted);
 
-  for (std::size_t i = 0; i < m_clones.size(); ++i) {
-    const auto local_transformation = m_clones[i]->transformation();
-    auto& clone = converted->adopt(m_clones[i]->clone());
+  const auto adopt = [&converted](std::unique_ptr<Object> object,
+                                  const ObjectTransformation& local_transformation,
+                                  const std::size_t i)
+  {
+    auto& clone = converted->adopt(std::move(object));
     const std::string name = clone.name() + " " + std::to_string(i);
     clone.property(NAME_PROPERTY_KEY)->set(name);
     clone.set_transformation(local_transformation);
+  };
+
+  // the instances are materialized only now.
+  for (std::size_t i = 0; i < m_instances.size(); ++i) {
+    const Instance& instance = m_instances[i];
+    adopt(tree_child(instance.child).clone(), instance.transformation, i);
+  }
+  for (std::size_t i = 0; i < m_clones.size(); ++i) {
+    adopt(m_clones[i]->clone(), m_clones[i]->transformation(), i);
   }
 
   return converted;
 }
 
-std::vector<std::unique_ptr<Object>> Cloner::make_clones()
+std::size_t Cloner::count() const
 {
-  const auto count = [this]() -> std::size_t {
-    switch (mode()) {
-    case Mode::Linear: [[fallthrough]];
-    case Mode::Radial: [[fallthrough]];
-    case Mode::Path: [[fallthrough]];
-    case Mode::Script: [[fallthrough]];
-    case Mode::FillRandom:
-      return static_cast<std::size_t>(property(COUNT_PROPERTY_KEY)->value<int>());
-    case Mode::Grid: {
-      const auto c = property(COUNT_2D_PROPERTY_KEY)->value<Vec2i>();
-      return static_cast<std::size_t>(c.x * c.y);
-    }
+  switch (mode()) {
+  case Mode::Linear: [[fallthrough]];
+  case Mode::Radial: [[fallthrough]];
+  case Mode::Path: [[fallthrough]];
+  case Mode::Script: [[fallthrough]];
+  case Mode::FillRandom:
+    return static_cast<std::size_t>(property(COUNT_PROPERTY_KEY)->value<int>());
+  case Mode::Grid: {
+    const auto c = property(COUNT_2D_PROPERTY_KEY)->value<Vec2i>();
+    return static_cast<std::size_t>(c.x * c.y);
+  }
+  }
+  Q_UNREACHABLE();
+}
+
+void Cloner::update_instance_structure()
+{
+  // the children are instantiated in turn.
+  const auto n_children = this->n_children();
+  const auto count = n_children > 0 ? this->count() : 0;
+  if (m_instances.size() != count || m_n_instantiated_children != n_children) {
+    m_instances.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      m_instances[i].child = i % n_children;
     }
-    Q_UNREACHABLE();
-  };
+    m_n_instantiated_children = n_children;
+  }
+}
 
+void Cloner::update_instance_layout()
+{
   const auto seed = property(SEED_PROPERTY_KEY)->value<int>();
   std::random_device dev;
   std::mt19937 rng(dev());
   rng.seed(static_cast<decltype(rng)::result_type>(seed));
 
-  auto clones = copy_children(count());
-  for (std::size_t i = 0; i < clones.size(); ++i) {
-    switch (mode()) {
-    case Mode::Linear: set_linear(*clones[i], i); break;
-    case Mode::Radial: set_radial(*clones[i], i); break;
-    case Mode::Path: set_path(*clones[i], i); break;
-    case Mode::Script: set_by_script(*clones[i], i); break;
-    case Mode::Grid: set_grid(*clones[i], i); break;
-    case Mode::FillRandom: set_fillrandom(*clones[i], rng); break;
+  const Mode mode = this->mode();
+  const auto locations = mode == Mode::Path ? path_locations(m_instances.size())
+                                            : std::vector<Point>();
+  for (std::size_t i = 0; i < m_instances.size(); ++i) {
+    Instance& instance = m_instances[i];
+    instance.transformation = tree_child(instance.child).transformation();
+    switch (mode) {
+    case Mode::Linear: set_linear(instance.transformation, i); break;
+    case Mode::Radial: set_radial(instance.transformation, i); break;
+    case Mode::Path:
+      if (!locations.empty()) { set_path(instance.transformation, locations[i]); }
+      break;
+    case Mode::Grid: set_grid(instance.transformation, i); break;
+    case Mode::FillRandom: set_fillrandom(instance.transformation, rng); break;
+    case Mode::Script: Q_UNREACHABLE();  // see `update`
     }
   }
+}
 
+std::vector<std::unique_ptr<Object>> Cloner::make_clones()
+{
+  auto clones = copy_children(count());
+  for (std::size_t i = 0; i < clones.size(); ++i) {
+    set_by_script(*clones[i], i);
+  }
   return clones;
 }
 
@@ -282,39 +364,49 @@ double Cloner::get_t(std::size_t i, const bool inclusive) const
   }
 }
 
-void Cloner::set_linear(Object& object, std::size_t i)
+void Cloner::set_linear(ObjectTransformation& transformation, std::size_t i) const
 {
   const Vec2f pos = static_cast<double>(i) * property(DISTANCE_2D_PROPERTY_KEY)->value<Vec2f>();
-  auto t = object.transformation();
-  t.set_translation(pos);
-  object.set_transformation(t);
+  transformation.set_translation(pos);
 }
 
-void Cloner::set_grid(Object& object, std::size_t i)
+void Cloner::set_grid(ObjectTransformation& transformation, std::size_t i) const
 {
   const auto n = property(COUNT_2D_PROPERTY_KEY)->value<Vec2i>();
   const auto v = property(DISTANCE_2D_PROPERTY_KEY)->value<Vec2f>();
-  auto t = object.transformation();
-  t.set_translation({ v.x * (i % static_cast<ulong>(n.x)),
-                      v.y * (i / static_cast<ulong>(n.x)) });
-  object.set_transformation(t);
+  transformation.set_translation({ v.x * (i % static_cast<ulong>(n.x)),
+                                   v.y * (i / static_cast<ulong>(n.x)) });
 }
 
-void Cloner::set_radial(Object& object, std::size_t i)
+void Cloner::set_radial(ObjectTransformation& transformation, std::size_t i) const
 {
   const double angle = 2*M_PI * get_t(i, false);
   const double r = property(RADIUS_PROPERTY_KEY)->value<double>();
   const Point op({std::cos(angle) * r, std::sin(angle) * r}, angle + M_PI/2.0);
-  object.set_oriented_position(op, property(ALIGN_PROPERTY_KEY)->value<bool>());
+  ::set_oriented_position(transformation, op, property(ALIGN_PROPERTY_KEY)->value<bool>());
 }
 
-void Cloner::set_path(Object& object, std::size_t i)
+std::vector<Point> Cloner::path_locations(const std::size_t n) const
 {
   auto* apo = property(PATH_REFERENCE_PROPERTY_KEY)->value<AbstractPropertyOwner*>();
   auto* o = kind_cast<Object*>(apo);
+  if (o == nullptr) {
+    return {};
+  }
+
+  std::vector<double> ts(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    ts[i] = std::clamp(get_t(i, !o->is_closed()), 0.0, 1.0);
+  }
+  const auto global_transformation = o->global_transformation(true);
+  return ::transform<Point>(o->evaluate(ts), [&global_transformation](const Point& p) {
+    return global_transformation.apply(p);
+  });
+}
 
-  const bool align = property(ALIGN_PROPERTY_KEY)->value<bool>();
-  object.set_position_on_path(o, align, get_t(i, o == nullptr ? false : !o->is_closed()), true);
+void Cloner::set_path(ObjectTransformation& transformation, const Point& location) const
+{
+  ::set_oriented_position(transformation, location, property(ALIGN_PROPERTY_KEY)->value<bool>());
 }
 
 void Cloner::set_by_script(Object& object, std::size_t i)
@@ -328,21 +420,44 @@ void Cloner::set_by_script(Object& object, std::size_t i)
   scene()->python_engine.exec(property(CODE_PROPERTY_KEY)->value<std::string>(), locals, this);
 }
 
-void Cloner::set_fillrandom(Object &object, std::mt19937& rng)
+void Cloner::set_fillrandom(ObjectTransformation& transformation, std::mt19937& rng) const
 {
   auto* apo = property(PATH_REFERENCE_PROPERTY_KEY)->value<AbstractPropertyOwner*>();
   if (apo != nullptr) {
     assert(apo->kind() == AbstractPropertyOwner::Kind::Object);
     auto& area = static_cast<Object&>(*apo);
+    const auto bounding_box = area.bounding_box();
 
-    auto position = [&rng, &area]() {
-      static constexpr auto max_rejections = 1000;
+    auto position = [&rng, &area, &bounding_box]() {
+      static constexpr std::size_t max_rejections = 1000;
+      static constexpr std::size_t batch_size = 16;
       auto dist = std::uniform_real_distribution<double>(0, 1);
-      for (std::size_t i = 0; i < max_rejections; ++i) {
-        const Vec2f p( dist(rng) * area.bounding_box().width() + area.bounding_box().left(),
-                       dist(rng) * area.bounding_box().height() + area.bounding_box().top() );
-        if (area.contains(p)) {
-          return p;
+      const auto sample = [&dist, &bounding_box](auto& generator) {
+        const double x = dist(generator) * bounding_box.width() + bounding_box.left();
+        const double y = dist(generator) * bounding_box.height() + bounding_box.top();
+        return Vec2f(x, y);
+      };
+
+      for (std::size_t i = 0; i < max_rejections; i += batch_size) {
+        // the candidates are drawn from a copy of `rng` such that `rng` can be advanced by
+        // exactly the number of candidates which were examined. Hence, the result does not depend
+        // on the batch size.
+        auto candidate_rng = rng;
+        std::vector<Vec2f> candidates;
+        candidates.reserve(batch_size);
+        for (std::size_t j = 0; j < std::min(batch_size, max_rejections - i); ++j) {
+          candidates.push_back(sample(candidate_rng));
+        }
+
+        const auto contains = area.contains(candidates);
+        const auto hit = std::find(contains.begin(), contains.end(), true);
+        const auto n_examined = std::min(candidates.size(),
+                                         std::size_t(std::distance(contains.begin(), hit)) + 1);
+        for (std::size_t j = 0; j < n_examined; ++j) {
+          sample(rng);
+        }
+        if (hit != contains.end()) {
+          return candidates[n_examined - 1];
         }
       }
 
@@ -354,10 +469,7 @@ void Cloner::set_fillrandom(Object &object, std::mt19937& rng)
     }();
 
     position = area.global_transformation(true).apply_to_position(position);
-
-    auto t = object.transformation();
-    t.set_translation(position);
-    object.set_transformation(t);
+    transformation.set_translation(position);
   }
 }
 
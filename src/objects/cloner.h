@@ -40,7 +40,10 @@ public:
   std::unique_ptr<Object> convert() const override;
   Mode mode() const;
   bool contains(const Vec2f &pos) const override;
+  using Object::contains;
   void update() override;
+  bool is_update_thread_safe() const override;
+  bool draws_descendants() const override;
 
 protected:
   void on_change(AbstractPropertyOwner* subject, int code, Property* property,
@@ -48,16 +51,44 @@ protected:
   void on_property_value_changed(Property& property, std::set<const void*> trace) override;
 
 private:
+  /**
+   * @brief an instance draws the subtree of a child with another transformation.
+   */
+  struct Instance
+  {
+    std::size_t child;
+    ObjectTransformation transformation;
+  };
+
+  std::size_t count() const;
+
+  /**
+   * @brief resizes `m_instances` and assigns the children to them if the count or the number of
+   *  children has changed.
+   */
+  void update_instance_structure();
+
+  /**
+   * @brief computes the transformations of the instances in place.
+   */
+  void update_instance_layout();
+
   std::vector<std::unique_ptr<Object>> make_clones();
   std::vector<std::unique_ptr<Object>> copy_children(const std::size_t n);
 
   double get_t(std::size_t i, const bool inclusive) const;
-  void set_linear(Object& object, std::size_t i);
-  void set_grid(Object& object, std::size_t i);
-  void set_radial(Object& object, std::size_t i);
-  void set_path(Object& object, std::size_t i);
+  void set_linear(ObjectTransformation& transformation, std::size_t i) const;
+  void set_grid(ObjectTransformation& transformation, std::size_t i) const;
+  void set_radial(ObjectTransformation& transformation, std::size_t i) const;
+  std::vector<Point> path_locations(const std::size_t n) const;
+  void set_path(ObjectTransformation& transformation, const Point& location) const;
   void set_by_script(Object& object, std::size_t i);
-  void set_fillrandom(Object& object, std::mt19937 &rng);
+  void set_fillrandom(ObjectTransformation& transformation, std::mt19937 &rng) const;
+
+  // the script may modify any property of a clone, hence clones are copies of the children in
+  // script mode. In all other modes, the children are instantiated and copied only by `convert`.
+  std::vector<Instance> m_instances;
+  std::size_t m_n_instantiated_children = 0;
   std::vector<std::unique_ptr<Object>> m_clones;
   std::set<Property*> m_clone_dependencies;
 
@@ -18,6 +18,7 @@ public:
   static constexpr auto FILEPATH_PROPERTY_KEY = "filename";
   static constexpr auto WIDTH_PROPERTY_KEY = "width";
   static constexpr auto OPACITY_PROPERTY_KEY = "opacity";
+  static constexpr auto IMAGE_LOADED = 3;
 };
 
 }  // namespace omm
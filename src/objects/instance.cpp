@@ -87,6 +87,8 @@ void Instance::update()
   }
 }
 
+// the referenced object is not a descendant, it may be read by other threads concurrently.
+bool Instance::is_update_thread_safe() const { return false; }
 
 std::unique_ptr<Object> Instance::convert() const
 {
@@ -27,6 +27,7 @@ public:
   Flag flags() const override;
   void post_create_hook() override;
   void update() override;
+  bool is_update_thread_safe() const override;
 
 private:
   Object* referenced_object() const;
@@ -6,6 +6,7 @@
 #include "properties/boolproperty.h"
 #include "geometry/vec2.h"
 #include "objects/path.h"
+#include "renderers/displaylist.h"
 
 namespace omm
 {
@@ -38,6 +39,14 @@ void Mirror::draw_object(Painter &renderer, const Style& style) const
   assert(&renderer.scene == scene());
   if (m_reflection) {
     m_reflection->draw_recursive(renderer, style);
+  } else if (reflects_object()) {
+    // the subtree of the first child is drawn once more, reflected.
+    const Object& child = tree_child(0);
+    DisplayList display_list;
+    child.append_display_lists(display_list, QTransform(), style);
+    renderer.push_transformation(get_mirror_t().apply(child.transformation()));
+    renderer.draw_display_list(display_list);
+    renderer.pop_transformation();
   }
 }
 
@@ -65,6 +74,10 @@ std::unique_ptr<Object> Mirror::convert() const
 
   if (m_reflection) {
     converted->adopt(m_reflection->clone());
+  } else if (reflects_object()) {
+    auto reflection = tree_child(0).clone();
+    reflection->set_transformation(get_mirror_t().apply(reflection->transformation()));
+    converted->adopt(std::move(reflection));
   }
 
   for (auto&& child : this->tree_children()) {
@@ -74,6 +87,14 @@ std::unique_ptr<Object> Mirror::convert() const
   return converted;
 }
 
+bool Mirror::draws_descendants() const { return true; }
+
+bool Mirror::reflects_object() const
+{
+  return is_active() && property(AS_PATH_PROPERTY_KEY)->value<Mode>() == Mode::Object
+      && n_children() > 0;
+}
+
 void Mirror::update()
 {
   m_reflection.reset();
@@ -87,9 +108,7 @@ void Mirror::update()
         if (!!(child.flags() & Object::Flag::IsPathLike) && !child.is_closed()) {
           auto combined_path = std::make_unique<Path>(scene());
           auto points = child.points();
-          auto mirrored_points = ::transform<Point>(child.points(), [=](const Point& p) {
-            return mirror_t.apply(p);
-          });
+          auto mirrored_points = mirror_t.apply(points);
 
           if (property(IS_INVERTED_PROPERTY_KEY)->value<bool>()) {
             for (auto& p : mirrored_points) {
@@ -109,11 +128,10 @@ void Mirror::update()
         }
       }
     } else {
+      // the first child is drawn reflected rather than cloned, see `draw_object`. Cloning would
+      // register the references of the clone at the referenced objects, which other threads may
+      // read concurrently.
       m_draw_children = true;
-      if (n_children > 0) {
-        m_reflection = this->tree_children().front()->clone();
-        m_reflection->set_transformation(mirror_t.apply(m_reflection->transformation()));
-      }
     }
   } else {
     m_draw_children = true;
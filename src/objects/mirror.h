@@ -31,10 +31,13 @@ public:
   virtual Flag flags() const override;
   std::unique_ptr<Object> convert() const override;
   void update() override;
+  bool draws_descendants() const override;
 
 private:
+  // the reflected path in Path mode.
   std::unique_ptr<Object> m_reflection;
   ObjectTransformation get_mirror_t() const;
+  bool reflects_object() const;
 
 };
 
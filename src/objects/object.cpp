@@ -2,7 +2,11 @@
 
 #include <cassert>
 #include <algorithm>
+#include <atomic>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <utility>
 #include <functional>
 #include <QObject>
 
@@ -30,6 +34,16 @@ static constexpr auto CHILDREN_POINTER = "children";
 static constexpr auto TAGS_POINTER = "tags";
 static constexpr auto TYPE_POINTER = "type";
 
+std::atomic<std::size_t> global_transformation_cache_hits = 0;
+std::atomic<std::size_t> global_transformation_cache_misses = 0;
+std::atomic<std::size_t> display_list_counter = 0;
+
+std::size_t next_global_transformation_revision()
+{
+  static std::atomic<std::size_t> revision = 0;
+  return ++revision;
+}
+
 }  // namespace
 
 namespace omm
@@ -127,13 +141,60 @@ ObjectTransformation Object::transformation() const
 
 ObjectTransformation Object::global_transformation(const bool skip_root) const
 {
-  if (is_root() || (skip_root && tree_parent().is_root())) {
-    return transformation();
+  return cached_global_transformation(skip_root).transformation;
+}
+
+Object::GlobalTransformationCache
+Object::cached_global_transformation(const bool skip_root) const
+{
+  // the parent is locked and released before this object is locked, hence no two locks are held
+  // at the same time.
+  const Object* parent = nullptr;
+  std::optional<GlobalTransformationCache> parent_cache;
+  if (!is_root() && !(skip_root && tree_parent().is_root())) {
+    parent = &tree_parent();
+    parent_cache = parent->cached_global_transformation(skip_root);
+  }
+  const std::size_t parent_revision = parent_cache ? parent_cache->revision : 0;
+
+  std::lock_guard<std::mutex> lock(m_global_transformation_cache_mutex);
+  auto& cache = m_global_transformation_cache[skip_root ? 1 : 0];
+  if (cache.revision != 0 && cache.parent == parent && cache.parent_revision == parent_revision
+      && cache.local_revision == m_local_transformation_revision) {
+    global_transformation_cache_hits += 1;
   } else {
-    // TODO caching could gain some speed
-    //  invalidate cache if local transformation is set or parent changes
-    return tree_parent().global_transformation(skip_root).apply(transformation());
+    global_transformation_cache_misses += 1;
+    if (!parent_cache) {
+      cache.transformation = transformation();
+    } else {
+      cache.transformation = parent_cache->transformation.apply(transformation());
+    }
+    cache.parent = parent;
+    cache.parent_revision = parent_revision;
+    cache.local_revision = m_local_transformation_revision;
+    cache.revision = next_global_transformation_revision();
   }
+  return cache;
+}
+
+Object::CacheStatistics Object::global_transformation_cache_statistics()
+{
+  CacheStatistics statistics;
+  statistics.hits = global_transformation_cache_hits;
+  statistics.misses = global_transformation_cache_misses;
+  return statistics;
+}
+
+void Object::reset_global_transformation_cache_statistics()
+{
+  global_transformation_cache_hits = 0;
+  global_transformation_cache_misses = 0;
+}
+
+double Object::CacheStatistics::hit_rate() const
+{
+  const std::size_t n = hits + misses;
+  return n == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(n);
 }
 
 void Object::set_transformation(const ObjectTransformation& transformation)
@@ -292,14 +353,99 @@ void Object::draw_recursive(Painter& renderer, const RenderOptions& options) con
   renderer.pop_transformation();
 }
 
+std::shared_ptr<const DisplayList> Object::display_list(const Style& default_style) const
+{
+  // some objects draw in global space (e.g., Cloner), i.e., they depend on their ancestors.
+  const std::size_t global_revision = cached_global_transformation(true).revision;
+
+  // the default style is used only if the object has no styles itself. It differs, e.g., if the
+  // object is drawn as the child of a Cloner. Style revisions are unique among all styles, hence
+  // they identify the styles and their state.
+  const auto& styles = find_styles();
+  const Style* fallback_style = styles.empty() ? &default_style : nullptr;
+  std::vector<std::size_t> style_revisions;
+  style_revisions.reserve(std::max(styles.size(), std::size_t(1)));
+  for (const auto* style : styles) {
+    style_revisions.push_back(style->revision());
+  }
+  if (fallback_style != nullptr) {
+    style_revisions.push_back(fallback_style->revision());
+  }
+
+  if (!m_display_list || m_display_list_revision != global_revision
+      || m_display_list_style_revisions != style_revisions)
+  {
+    assert(m_scene != nullptr);
+    auto display_list = std::make_shared<DisplayList>();
+    Painter recorder(*m_scene, Painter::Category::Objects);
+    recorder.display_list = display_list.get();
+    for (const auto* style : styles) {
+      draw_object(recorder, *style);
+    }
+    if (fallback_style != nullptr) {
+      draw_object(recorder, *fallback_style);
+    }
+    m_display_list = display_list;
+    m_display_list_revision = global_revision;
+    m_display_list_style_revisions = std::move(style_revisions);
+    m_display_list_id = ++display_list_counter;
+  }
+  return m_display_list;
+}
+
+std::size_t Object::append_display_lists(DisplayList& list, const QTransform& transformation,
+                                         const Style& default_style) const
+{
+  // the group allows to cull or rasterize this object and its descendants at once.
+  // The root is not rasterized because its transformation changes while panning.
+  const std::size_t group = list.begin_group(is_root() ? nullptr : this);
+
+  // any change in the subtree drops or records the display list of the changed object, both
+  // assign an id which is greater than all ids assigned before.
+  const auto visibility = property(IS_VISIBLE_PROPERTY_KEY)->value<Visibility>();
+  if (visibility == Visibility::Visible) {
+    list.append(*display_list(default_style), transformation);
+  }
+  std::size_t revision = m_display_list_id;
+  if (visibility != Visibility::HideTree && m_draw_children) {
+    for (const auto& child : tree_children()) {
+      const QTransform child_transformation = Painter::to_qtransform(child->transformation());
+      const std::size_t child_revision
+          = child->append_display_lists(list, child_transformation * transformation,
+                                        default_style);
+      revision = std::max(revision, child_revision);
+    }
+  }
+  list.end_group(group, m_display_list_id, revision);
+  return revision;
+}
+
 BoundingBox Object::recursive_bounding_box() const
 {
-  auto bounding_box = this->bounding_box();
+  if (!m_recursive_bounding_box) {
+    auto bounding_box = this->bounding_box();
+    for (const auto& child : tree_children()) {
+      bounding_box |= child->recursive_bounding_box();
+    }
+    m_recursive_bounding_box = std::make_shared<const BoundingBox>(
+                                 transformation().apply(bounding_box));
+  }
+  return *m_recursive_bounding_box;
+}
 
-  for (const auto& child : tree_children()) {
-    bounding_box |= child->recursive_bounding_box();
+void Object::invalidate_recursive_bounding_box()
+{
+  // if the cache of this object is invalid, the caches of its ancestors are invalid, too,
+  // because computing the recursive bounding box of an object validates all its descendants.
+  Object* object = this;
+  while (object->m_recursive_bounding_box) {
+    object->m_recursive_bounding_box.reset();
+    if (object->is_root()) {
+      break;
+    } else {
+      object = &object->tree_parent();
+    }
   }
-  return transformation().apply(bounding_box);
 }
 
 std::unique_ptr<AbstractRAIIGuard> Object::acquire_set_parent_guard()
@@ -341,10 +487,19 @@ void Object::copy_tags(Object& other) const
 void Object::on_change(AbstractPropertyOwner* subject, int what, Property* property,
                        std::set<const void *> trace)
 {
+  // any change of this object or of its descendants may change the recursive bounding box and
+  // requires an update. Changes of referenced objects arrive here, too (see ReferenceProperty).
+  if (!std::exchange(m_is_notified_by_descendant, false)) {
+    m_has_own_changes = true;
+  }
+  m_recursive_bounding_box.reset();
+  m_is_dirty = true;
   if (!is_root()) {
     auto ts = trace;
     ts.insert(this);
-    tree_parent().on_change(subject, what, property, ts);
+    Object& parent = tree_parent();
+    parent.m_is_notified_by_descendant = true;
+    parent.on_change(subject, what, property, ts);
   }
   AbstractPropertyOwner::on_change(subject, what, property, trace);
 }
@@ -359,6 +514,13 @@ void Object::on_children_changed(std::set<const void *> trace)
 
 void Object::on_property_value_changed(Property &property, std::set<const void *> trace)
 {
+  if (&property == this->property(POSITION_PROPERTY_KEY)
+      || &property == this->property(SCALE_PROPERTY_KEY)
+      || &property == this->property(ROTATION_PROPERTY_KEY)
+      || &property == this->property(SHEAR_PROPERTY_KEY)) {
+    m_local_transformation_revision += 1;
+  }
+
   if (property.type() == ReferenceProperty::TYPE) {
     Object* reference = kind_cast<Object*>(property.value<AbstractPropertyOwner*>());
     if (reference != nullptr && reference->is_ancestor_of(*this)) {
@@ -391,6 +553,11 @@ Point Object::evaluate(const double t) const
   return Point();
 }
 
+std::vector<Point> Object::evaluate(const std::vector<double>& ts) const
+{
+  return ::transform<Point>(ts, [this](const double t) { return evaluate(t); });
+}
+
 double Object::path_length() const { return -1.0; }
 bool Object::is_closed() const { return false; }
 
@@ -442,7 +609,7 @@ Object::Visibility Object::visibility() const
   return property(IS_VISIBLE_PROPERTY_KEY)->value<Visibility>();
 }
 
-std::vector<const omm::Style*> Object::find_styles() const
+const std::vector<const omm::Style*>& Object::find_styles() const
 {
   const auto get_style = [](const omm::Tag* tag) -> const omm::Style* {
     if (tag->type() == omm::StyleTag::TYPE) {
@@ -456,8 +623,12 @@ std::vector<const omm::Style*> Object::find_styles() const
     }
   };
 
-  const auto tags = this->tags.ordered_items();
-  return ::filter_if(::transform<const omm::Style*>(tags, get_style), ::is_not_null);
+  if (m_styles_revision != tags.revision()) {
+    const auto tags = this->tags.ordered_items();
+    m_styles = ::filter_if(::transform<const omm::Style*>(tags, get_style), ::is_not_null);
+    m_styles_revision = this->tags.revision();
+  }
+  return m_styles;
 }
 
 bool Object::contains(const Vec2f &point) const
@@ -466,15 +637,33 @@ bool Object::contains(const Vec2f &point) const
   return false;
 }
 
-void Object::update_recursive()
+std::vector<bool> Object::contains(const std::vector<Vec2f>& positions) const
+{
+  return ::transform<bool>(positions, [this](const Vec2f& pos) { return contains(pos); });
+}
+
+void Object::update_and_mark_clean()
 {
-  // it's important to first update the children because of the way e.g. Cloner does its caching.
-  for (auto* child : tree_children()) {
-    child->update_recursive();
-  }
   update();
+
+  // the ancestors are updated later, too. Hence it's sufficient to invalidate this bounding box.
+  m_recursive_bounding_box.reset();
+
+  // an object which is not dirty is updated because an object it depends on has been updated.
+  // The ancestors of a changed object draw the same as before unless they draw their descendants.
+  if (m_has_own_changes || !m_is_dirty || draws_descendants()) {
+    m_display_list.reset();
+    m_display_list_id = ++display_list_counter;
+  }
+  m_has_own_changes = false;
+  m_is_dirty = false;
 }
 
+bool Object::is_update_thread_safe() const { return !(flags() & Flag::HasScript); }
+bool Object::draws_descendants() const { return false; }
+
+bool Object::is_dirty() const { return m_is_dirty; }
+
 void Object::update() { }
 void Object::draw_object(Painter&, const Style&) const {}
 void Object::draw_handles(Painter&) const {}
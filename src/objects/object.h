@@ -1,7 +1,9 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include "external/json_fwd.hpp"
 #include "geometry/objecttransformation.h"
 #include "aspects/propertyowner.h"
@@ -42,7 +44,30 @@ public:
 
   void transform(const ObjectTransformation& transformation);
   ObjectTransformation transformation() const;
+
+  /**
+   * @brief returns the transformation of this object relative to the scene root (or its child
+   *  if `skip_root` is true).
+   *  The result is cached. The cache is invalidated if the local transformation of this object or
+   *  of any of its ancestors changes or if this object or any of its ancestors is reparented.
+   *  The invalidation is lazy, i.e., it does not need to visit the descendants.
+   */
   ObjectTransformation global_transformation(const bool skip_root = false) const;
+
+  struct CacheStatistics
+  {
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    double hit_rate() const;
+  };
+
+  /**
+   * @brief returns how many global transformation lookups (including the implied lookups of the
+   *  ancestors) were answered from the cache since the last reset.
+   */
+  static CacheStatistics global_transformation_cache_statistics();
+  static void reset_global_transformation_cache_statistics();
+
   void set_transformation(const ObjectTransformation& transformation);
   void set_global_transformation( const ObjectTransformation& global_transformation,
                                   const bool skip_root = false );
@@ -65,7 +90,27 @@ public:
 
   void draw_recursive(Painter& renderer, const Style& default_style) const;
   void draw_recursive(Painter& renderer, const RenderOptions& options) const;
+
+  /**
+   * @brief returns what `draw_object` draws, in the coordinate system of this object.
+   *  The list is recorded lazily and kept until this object changes, its global transformation
+   *  changes or, if it draws its descendants, one of its descendants changes.
+   */
+  std::shared_ptr<const DisplayList> display_list(const Style& default_style) const;
+
+  /**
+   * @brief appends the display lists of this object and of its visible descendants to `list`.
+   * @param transformation maps the coordinate system of this object to the one of `list`.
+   * @return a revision which changes whenever anything in the subtree is drawn differently.
+   */
+  std::size_t append_display_lists(DisplayList& list, const QTransform& transformation,
+                                   const Style& default_style) const;
   virtual BoundingBox bounding_box() const = 0;
+
+  /**
+   * @brief returns the bounding box of this object and its descendants in the parent's space.
+   *  The result is cached until this object or any of its descendants changes.
+   */
   BoundingBox recursive_bounding_box() const;
   std::unique_ptr<AbstractRAIIGuard> acquire_set_parent_guard() override;
   virtual std::unique_ptr<Object> clone() const = 0;
@@ -76,7 +121,7 @@ public:
   bool is_active() const;
   bool is_visible() const;
   Visibility visibility() const;
-  virtual std::vector<const omm::Style*> find_styles() const;
+  virtual const std::vector<const omm::Style*>& find_styles() const;
 
   List<Tag> tags;
   template<typename T, template<typename...> class ContainerT>
@@ -100,6 +145,7 @@ public:
   enum class Border { Clamp, Wrap, Hide, Reflect };
   static double apply_border(double t, Border border);
   virtual Point evaluate(const double t) const;
+  virtual std::vector<Point> evaluate(const std::vector<double>& ts) const;
   virtual double path_length() const;
   virtual bool is_closed() const;
   void set_position_on_path(AbstractPropertyOwner* path, const bool align, const double t,
@@ -109,8 +155,33 @@ public:
   virtual std::vector<Point> points() const;
 
   virtual bool contains(const Vec2f& pos) const;
+  virtual std::vector<bool> contains(const std::vector<Vec2f>& positions) const;
   virtual void update();
-  void update_recursive();
+
+  /**
+   * @brief calls `update` and marks this object clean.
+   *  An object is dirty if it, one of its descendants or an object it references has changed
+   *  since its last update. The order of evaluation is defined by the DependencyGraph.
+   */
+  void update_and_mark_clean();
+  bool is_dirty() const;
+
+  /**
+   * @brief returns whether `update` may run on a worker thread.
+   *  Such an update must not run Python code, it must not modify other objects than this one
+   *  and it must not trigger lazy computations of other objects. It may create and destroy
+   *  objects which only this object knows of, as long as they neither reference other objects
+   *  (a reference registers at the referenced object) nor rely on events (they are QObjects
+   *  which belong to the worker thread).
+   *  Objects which have the HasScript flag are not thread safe by default.
+   */
+  virtual bool is_update_thread_safe() const;
+
+  /**
+   * @brief returns whether `draw_object` draws the descendants of this object (e.g., Cloner).
+   *  Otherwise, an update which is caused by changed descendants only keeps the display list.
+   */
+  virtual bool draws_descendants() const;
 
   void on_change(AbstractPropertyOwner* subject, int what, Property* property,
                  std::set<const void*> trace) override;
@@ -123,10 +194,56 @@ protected:
   bool m_draw_children = true;
   void copy_tags(Object& other) const;
 
+  /**
+   * @brief must be called if `bounding_box` changed without a call of `on_change`.
+   *  Invalidates the cached recursive bounding box of this object and of its ancestors.
+   */
+  void invalidate_recursive_bounding_box();
+
 private:
   friend class ObjectView;
   Scene* m_scene;
   void set_scene(Scene* scene);
+
+  struct GlobalTransformationCache
+  {
+    ObjectTransformation transformation;
+
+    // the cache is valid if neither the parent, its revision nor the local revision changed.
+    const Object* parent = nullptr;
+    std::size_t parent_revision = 0;
+    std::size_t local_revision = 0;
+
+    // unique among all cache entries, 0 if the entry is invalid.
+    std::size_t revision = 0;
+  };
+
+  // one entry for `skip_root == false` and one for `skip_root == true`.
+  mutable std::array<GlobalTransformationCache, 2> m_global_transformation_cache;
+  std::size_t m_local_transformation_revision = 1;
+
+  // the cache may be queried concurrently, e.g., by the descendants of this object.
+  mutable std::mutex m_global_transformation_cache_mutex;
+  GlobalTransformationCache cached_global_transformation(const bool skip_root) const;
+
+  mutable std::shared_ptr<const BoundingBox> m_recursive_bounding_box;
+  bool m_is_dirty = true;
+
+  // whether this object has changed itself rather than only its descendants since its last
+  // update. The flag is set on the parent while a descendant notifies it, see `on_change`.
+  bool m_has_own_changes = true;
+  bool m_is_notified_by_descendant = false;
+
+  // the global transformation revision and the revisions of the styles the display list has been
+  // recorded with.
+  mutable std::shared_ptr<const DisplayList> m_display_list;
+  mutable std::size_t m_display_list_revision = 0;
+  mutable std::vector<std::size_t> m_display_list_style_revisions;
+  mutable std::size_t m_display_list_id = 0;  // changes whenever the list is dropped or recorded.
+
+  // the styles are valid if m_styles_revision equals the revision of `tags`.
+  mutable std::vector<const Style*> m_styles;
+  mutable std::size_t m_styles_revision = 0;
 };
 
 void register_objects();
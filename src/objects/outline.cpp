@@ -67,6 +67,15 @@ Point Outline::evaluate(const double t) const
   }
 }
 
+std::vector<Point> Outline::evaluate(const std::vector<double>& ts) const
+{
+  if (m_outline) {
+    return m_outline->evaluate(ts);
+  } else {
+    return std::vector<Point>(ts.size());
+  }
+}
+
 double Outline::path_length() const
 {
   if (m_outline) {
@@ -78,9 +87,6 @@ double Outline::path_length() const
 
 bool Outline::contains(const Vec2f &pos) const
 {
-  auto* ref = kind_cast<Object*>(property(REFERENCE_PROPERTY_KEY)->value<AbstractPropertyOwner*>());
-  if (ref) {ref->update(); }
-
   if (m_outline) {
     return m_outline->contains(pos);
   } else {
@@ -88,6 +94,15 @@ bool Outline::contains(const Vec2f &pos) const
   }
 }
 
+std::vector<bool> Outline::contains(const std::vector<Vec2f>& positions) const
+{
+  if (m_outline) {
+    return m_outline->contains(positions);
+  } else {
+    return std::vector<bool>(positions.size(), false);
+  }
+}
+
 std::unique_ptr<Object> Outline::convert() const
 {
   auto converted = m_outline->clone();
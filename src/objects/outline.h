@@ -29,8 +29,10 @@ public:
   void update() override;
 
   Point evaluate(const double t) const override;
+  std::vector<Point> evaluate(const std::vector<double>& ts) const override;
   double path_length() const override;
   bool contains(const Vec2f &pos) const override;
+  std::vector<bool> contains(const std::vector<Vec2f>& positions) const override;
 
 private:
   PathUniquePtr m_outline;
@@ -68,18 +68,32 @@ Path::Path(Scene* scene) : Object(scene)
     .set_post_submit(update_point_tangents).set_pre_submit(update_point_tangents);
 }
 
+Path::Path(const Path& other)
+  : Object(other)
+  , m_points(other.m_points)
+  , m_geometry_revision(other.m_geometry_revision)
+  , m_cubics(other.m_cubics ? std::make_shared<Cubics>(*other.m_cubics) : nullptr)
+{
+}
+
 void Path::draw_object(Painter &renderer, const Style& style) const
 {
   const auto triangulation_style = ContourStyle(Colors::BLACK, 0.5);
   const auto marked_triangulation_style = ContourStyle(Colors::GREEN, 2.0);
   renderer.set_style(style);
-  renderer.painter->drawPath(m_painter_path);
+  cubics();  // makes sure that m_cubics exists.
+  renderer.draw_path(m_cubics);
 }
 
-BoundingBox Path::bounding_box() const { return BoundingBox(m_points); }
+BoundingBox Path::bounding_box() const { return cubics().bounding_box(); }
 std::string Path::type() const { return TYPE; }
 std::unique_ptr<Object> Path::clone() const { return std::make_unique<Path>(*this); }
-void Path::set_points(const std::vector<Point>& points) { m_points = points; }
+void Path::set_points(const std::vector<Point>& points)
+{
+  m_points = points;
+  invalidate_geometry();
+}
+
 std::vector<Point> Path::points() const { return m_points; }
 
 std::vector<Point*> Path::points_ref()
@@ -112,6 +126,7 @@ void Path::deserialize(AbstractDeserializer& deserializer, const Pointer& root)
     const auto point_pointer = make_pointer(points_pointer, i);
     m_points[i] = deserialize_point(deserializer, point_pointer);
   }
+  invalidate_geometry();
 }
 
 void Path::deselect_all_points()
@@ -163,9 +178,54 @@ Point Path::smoothed(const std::size_t& i) const
 
 bool Path::contains(const Vec2f &pos) const { return cubics().contains(pos); }
 
-void Path::update()
+std::vector<bool> Path::contains(const std::vector<Vec2f>& positions) const
+{
+  return cubics().contains(positions);
+}
+
+void Path::on_change(AbstractPropertyOwner* subject, int what, Property* property,
+                     std::set<const void*> trace)
+{
+  if (subject == this && what == POINTS_CHANGED) {
+    invalidate_geometry();
+  }
+  Object::on_change(subject, what, property, trace);
+}
+
+void Path::on_property_value_changed(Property& property, std::set<const void*> trace)
+{
+  if (&property == this->property(IS_CLOSED_PROPERTY_KEY)) {
+    invalidate_geometry();
+  }
+  Object::on_property_value_changed(property, trace);
+}
+
+void Path::invalidate_geometry()
+{
+  m_geometry_revision += 1;
+  m_cubics.reset();
+  invalidate_recursive_bounding_box();
+}
+
+std::size_t Path::geometry_revision() const { return m_geometry_revision; }
+
+void Path::on_points_changed(const std::set<std::size_t>& indices, std::set<const void*> trace)
+{
+  if (m_cubics) {
+    // the display lists which share the cache are recorded again, see `m_cubics`.
+    m_cubics->update(m_points, indices);
+  }
+  m_geometry_revision += 1;
+  invalidate_recursive_bounding_box();
+
+  // Path::on_change would drop the updated cache.
+  Object::on_change(this, POINTS_CHANGED, nullptr, trace);
+}
+
+std::size_t Path::point_index(const Point* point) const
 {
-  m_painter_path = Painter::path(m_points, property(IS_CLOSED_PROPERTY_KEY)->value<bool>());
+  assert(point >= m_points.data() && point < m_points.data() + m_points.size());
+  return static_cast<std::size_t>(point - m_points.data());
 }
 
 bool Path::is_closed() const
@@ -178,7 +238,18 @@ Point Path::evaluate(const double t) const
   return cubics().evaluate(t);
 }
 
-Cubics Path::cubics() const { return Cubics(m_points, is_closed()); }
+std::vector<Point> Path::evaluate(const std::vector<double>& ts) const
+{
+  return cubics().evaluate(ts);
+}
+
+const Cubics& Path::cubics() const
+{
+  if (!m_cubics) {
+    m_cubics = std::make_shared<Cubics>(m_points, is_closed());
+  }
+  return *m_cubics;
+}
 
 double Path::path_length() const
 {
@@ -206,6 +277,7 @@ std::vector<std::size_t> Path::add_points(const PointSequence& sequence)
   for (std::size_t j = 0; j < n; ++j) {
     points.push_back(sequence.position);
   }
+  invalidate_geometry();
   return points;
 }
 
@@ -245,6 +317,7 @@ std::vector<Path::PointSequence> Path::remove_points(std::vector<std::size_t> in
     }
     m_points.erase(std::next(m_points.begin(), static_cast<int>(i)));
   }
+  invalidate_geometry();
 
   return std::vector(sequences.begin(), sequences.end());
 }
@@ -259,6 +332,7 @@ void Path::set_global_axis_transformation( const ObjectTransformation& global_tr
   for (auto& point : m_points) {
     point = td.apply(point);
   }
+  invalidate_geometry();
 }
 
 std::vector<double> Path::cut(const Vec2f& c_start, const Vec2f& c_end)
@@ -269,20 +343,18 @@ std::vector<double> Path::cut(const Vec2f& c_start, const Vec2f& c_end)
 
 std::vector<Path::PointSequence> Path::get_point_sequences(const std::vector<double> &ts) const
 {
-  const auto cubics = this->cubics();
+  const auto& cubics = this->cubics();
   std::map<std::size_t, std::list<double>> sequences_t;
   for (double t : ts) {
     const auto [segment_i, segment_t] = cubics.path_to_segment(t);
     sequences_t[segment_i].push_back(segment_t);
   }
 
-  const auto f = [cubics](auto i_ts) {
+  const auto f = [&cubics](auto i_ts) {
     auto [segment_i, sequence_t] = i_ts;
     sequence_t.sort();
-    const auto f = [segment_i=segment_i, cubics](const double segment_t) {
-      return cubics.segment(segment_i).evaluate(segment_t);
-    };
-    return PointSequence(segment_i + 1, ::transform<Point>(sequence_t, f));
+    const auto segment_ts = std::vector(sequence_t.begin(), sequence_t.end());
+    return PointSequence(segment_i + 1, cubics.segment(segment_i).evaluate(segment_ts));
   };
 
   auto sequences = ::transform<PointSequence, std::vector>(sequences_t, f);
@@ -307,6 +379,7 @@ void Path::update_tangents()
     }
     break;
   }
+  invalidate_geometry();
 }
 
 Object::PathUniquePtr Path::outline(const double t) const
@@ -3,6 +3,7 @@
 #include "objects/object.h"
 #include "geometry/point.h"
 #include <list>
+#include <set>
 #include "geometry/cubics.h"
 
 namespace omm
@@ -14,6 +15,7 @@ class Path : public Object
 {
 public:
   explicit Path(Scene* scene);
+  Path(const Path& other);
   void draw_object(Painter& renderer, const Style& style) const override;
   BoundingBox bounding_box() const override;
   std::string type() const override;
@@ -21,7 +23,32 @@ public:
   std::unique_ptr<Object> clone() const override;
   std::vector<Point> points() const override;
   std::vector<Point*> points_ref();
-  Cubics cubics() const;
+
+  /**
+   * @brief returns the segments of this path.
+   *  The result is cached until the geometry changes, i.e., until geometry_revision() changes.
+   */
+  const Cubics& cubics() const;
+
+  /**
+   * @brief the geometry revision is incremented whenever the points or the closed-flag change.
+   *  If points are modified through `points_ref`, `on_change` must be called with
+   *  `POINTS_CHANGED` afterwards. If only few points were modified, `on_points_changed` is
+   *  preferable.
+   */
+  std::size_t geometry_revision() const;
+
+  /**
+   * @brief must be called after the points with indices `indices` were modified through
+   *  `points_ref`. Unlike `on_change` with `POINTS_CHANGED`, only the segments adjacent to these
+   *  points are rebuilt. Notifies the observers like `on_change`.
+   */
+  void on_points_changed(const std::set<std::size_t>& indices, std::set<const void*> trace);
+
+  /**
+   * @brief returns the index of `point`, which must have been obtained by `points_ref`.
+   */
+  std::size_t point_index(const Point* point) const;
   void set_points(const std::vector<Point>& points);
   static constexpr auto IS_CLOSED_PROPERTY_KEY = "closed";
   static constexpr auto POINTS_POINTER = "points";
@@ -65,18 +92,28 @@ public:
   Point smoothed(const std::size_t& i) const;
 
   Point evaluate(const double t) const override;
+  std::vector<Point> evaluate(const std::vector<double>& ts) const override;
   double path_length() const override;
   bool contains(const Vec2f &pos) const override;
-  void update() override;
+  std::vector<bool> contains(const std::vector<Vec2f>& positions) const override;
+
+  void on_change(AbstractPropertyOwner* subject, int what, Property* property,
+                 std::set<const void*> trace) override;
+  void on_property_value_changed(Property& property, std::set<const void*> trace) override;
 
 private:
   std::vector<Point> m_points;
+  std::size_t m_geometry_revision = 0;
+
+  // the cache is shared with display lists only (not with clones), hence it can be updated in
+  // place. The display lists are recorded again after any change of the geometry.
+  mutable std::shared_ptr<Cubics> m_cubics;
+  void invalidate_geometry();
   /**
    * @brief this function does not notifiy the active tool.
    *  use the overload add_points(const std::vector<PointSequence>&);
    */
   std::vector<std::size_t> add_points(const PointSequence& sequence);
-  QPainterPath m_painter_path;
 };
 
 }  // namespace omm
@@ -1,7 +1,17 @@
 #include "properties/referenceproperty.h"
+#include <mutex>
 #include "objects/object.h"
 #include "tags/tag.h"
 
+namespace
+{
+
+// objects are cloned on worker threads during parallel evaluation. The clones of reference
+// properties register at the referenced objects, which are shared.
+std::mutex registration_mutex;
+
+}  // namespace
+
 namespace omm
 {
 
@@ -18,7 +28,10 @@ ReferenceProperty::ReferenceProperty(const ReferenceProperty &other)
 {
   auto* value = this->value();
   if (value != nullptr) {
-    value->register_observer(&m_referenceproperty_reference_observer);
+    {
+      std::lock_guard<std::mutex> lock(registration_mutex);
+      value->register_observer(&m_referenceproperty_reference_observer);
+    }
 
     // set is virtual, will be called in TypedProperty-constructor.
     // Make sure to call ReferenceProperty::set
@@ -93,12 +106,14 @@ void ReferenceProperty::set(AbstractPropertyOwner * const &apo)
 {
   auto* old_apo = value();
   if (old_apo) {
+    std::lock_guard<std::mutex> lock(registration_mutex);
     old_apo->unregister_observer(&m_referenceproperty_reference_observer);
     unregister_observer(apo);
     old_apo->m_referees.erase(this);
   }
   TypedProperty::set(apo);
   if (apo) {
+    std::lock_guard<std::mutex> lock(registration_mutex);
     apo->register_observer(&m_referenceproperty_reference_observer);
     register_observer(apo);
     apo->m_referees.insert(this);
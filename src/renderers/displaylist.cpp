@@ -0,0 +1,367 @@
+#include "renderers/displaylist.h"
+#include <algorithm>
+#include <cmath>
+#include <QFontMetricsF>
+#include <QPainter>
+#include "geometry/cubics.h"
+#include "renderers/painter.h"
+#include "renderers/rastercache.h"
+
+namespace
+{
+
+// objects closer to the viewport than that (in pixels) are drawn.
+constexpr double CULL_MARGIN = 2.0;
+constexpr double HUGE_NUMBER = 10e10;
+
+// groups with at least that many commands or with any text or image are rasterized.
+constexpr std::size_t MIN_N_EXPENSIVE_COMMANDS = 64;
+
+// groups which cover more than that many viewports are not rasterized.
+constexpr double MAX_RELATIVE_RASTER_AREA = 4.0;
+
+// unlike QRectF::intersects, this is true for touching or degenerated rectangles.
+bool overlap(const QRectF& a, const QRectF& b)
+{
+  return a.left() <= b.right() && b.left() <= a.right()
+      && a.top() <= b.bottom() && b.top() <= a.bottom();
+}
+
+}  // namespace
+
+namespace omm
+{
+
+bool DisplayList::Paint::operator==(const Paint& other) const
+{
+  return pen == other.pen && brush == other.brush;
+}
+
+void DisplayList::add_command(const Kind kind, const QTransform& transformation,
+                              const Paint& paint, const std::size_t item, const QRectF& bounds)
+{
+  m_commands.push_back({ kind, add_transformation(transformation), add_paint(paint), item,
+                         transformation.mapRect(bounds) });
+}
+
+void DisplayList::add_path(const QTransform& transformation, const Paint& paint,
+                           std::shared_ptr<const Cubics> cubics)
+{
+  QRectF bounds = cubics->bounding_box();
+  if (paint.pen.style() != Qt::NoPen) {
+    // miter joins may exceed the half pen width.
+    const double margin = paint.pen.widthF() * std::max(1.0, paint.pen.miterLimit()) / 2.0;
+    bounds.adjust(-margin, -margin, margin, margin);
+  }
+  const std::size_t item = m_paths.size();
+  m_paths.push_back(std::move(cubics));
+  add_command(Kind::Path, transformation, paint, item, bounds);
+}
+
+void DisplayList::add_text(const QTransform& transformation, const Paint& paint, Text text)
+{
+  const std::size_t item = m_texts.size();
+  // glyphs may exceed the layout a little bit (e.g., italic ones).
+  const double margin = QFontMetricsF(text.font).height();
+  const QRectF bounds = QRectF(text.pos, text.text.size()).adjusted(-margin, -margin,
+                                                                     margin, margin);
+  m_texts.push_back(std::move(text));
+  add_command(Kind::Text, transformation, paint, item, bounds);
+}
+
+void DisplayList::add_image(const QTransform& transformation, Image image)
+{
+  QRectF bounds;
+  if (image.height) {
+    bounds = QRectF(image.pos.to_pointf(), QSizeF(image.width, *image.height)).normalized();
+  } else {
+    // the height is not known before the image is loaded.
+    bounds = QRectF(-HUGE_NUMBER / 2.0, -HUGE_NUMBER / 2.0, HUGE_NUMBER, HUGE_NUMBER);
+  }
+  const std::size_t item = m_images.size();
+  m_images.push_back(std::move(image));
+  add_command(Kind::Image, transformation, Paint(), item, bounds);
+}
+
+void DisplayList::append(const DisplayList& other, const QTransform& transformation)
+{
+  const std::size_t command_offset = m_commands.size();
+  const std::size_t group_offset = m_groups.size();
+  append_commands(other, transformation);
+  for (Group group : other.m_groups) {
+    group.begin_command += command_offset;
+    group.end_command += command_offset;
+    group.end_group += group_offset;
+    group.bounds = transformation.mapRect(group.bounds);
+    group.own_bounds = transformation.mapRect(group.own_bounds);
+    m_groups.push_back(group);
+  }
+}
+
+void DisplayList::append_commands(const DisplayList& other, const QTransform& transformation)
+{
+  const std::size_t transformation_offset = m_transformations.size();
+  const std::size_t paint_offset = m_paints.size();
+  m_transformations.reserve(m_transformations.size() + other.m_transformations.size());
+  for (const QTransform& t : other.m_transformations) {
+    m_transformations.push_back(t * transformation);
+  }
+  m_paints.insert(m_paints.end(), other.m_paints.begin(), other.m_paints.end());
+
+  m_commands.reserve(m_commands.size() + other.m_commands.size());
+  for (Command command : other.m_commands) {
+    command.transformation += transformation_offset;
+    command.paint += paint_offset;
+    switch (command.kind) {
+    case Kind::Path: command.item += m_paths.size(); break;
+    case Kind::Text: command.item += m_texts.size(); break;
+    case Kind::Image: command.item += m_images.size(); break;
+    }
+    command.bounds = transformation.mapRect(command.bounds);
+    m_commands.push_back(command);
+  }
+  m_paths.insert(m_paths.end(), other.m_paths.begin(), other.m_paths.end());
+  m_texts.insert(m_texts.end(), other.m_texts.begin(), other.m_texts.end());
+  m_images.insert(m_images.end(), other.m_images.begin(), other.m_images.end());
+}
+
+std::size_t DisplayList::begin_group(const void* key)
+{
+  m_groups.push_back({ m_commands.size(), m_commands.size(), m_groups.size() + 1, QRectF(),
+                       key, 0, false, QRectF(), 0 });
+  return m_groups.size() - 1;
+}
+
+void DisplayList::end_group(const std::size_t index, const std::size_t own_revision,
+                            const std::size_t revision)
+{
+  Group& group = m_groups[index];
+  group.end_command = m_commands.size();
+  group.end_group = m_groups.size();
+  group.own_revision = own_revision;
+  group.revision = revision;
+  group.is_expensive = group.end_command - group.begin_command >= MIN_N_EXPENSIVE_COMMANDS;
+
+  const auto add_commands = [this, &group](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      group.own_bounds |= m_commands[i].bounds;
+      group.is_expensive |= m_commands[i].kind != Kind::Path;
+    }
+  };
+
+  // the bounds of the nested groups are known already.
+  std::size_t command = group.begin_command;
+  for (std::size_t i = index + 1; i < group.end_group; i = m_groups[i].end_group) {
+    add_commands(command, m_groups[i].begin_command);
+    group.bounds |= m_groups[i].bounds;
+    group.is_expensive |= m_groups[i].is_expensive;
+    command = m_groups[i].end_command;
+  }
+  add_commands(command, group.end_command);
+  group.bounds |= group.own_bounds;
+}
+
+std::vector<QRectF> DisplayList::damage(const DisplayList& before, const DisplayList& after)
+{
+  std::map<const void*, const Group*> groups_before;
+  for (const Group& group : before.m_groups) {
+    if (group.key != nullptr) {
+      groups_before.emplace(group.key, &group);
+    }
+  }
+
+  std::vector<QRectF> damage;
+  const auto add_damage = [&damage](const QRectF& rect) {
+    if (!rect.isNull()) {
+      damage.push_back(rect);
+    }
+  };
+
+  for (const Group& group : after.m_groups) {
+    const auto it = group.key == nullptr ? groups_before.end() : groups_before.find(group.key);
+    if (it == groups_before.end()) {
+      add_damage(group.own_bounds);
+    } else {
+      const Group& group_before = *it->second;
+      if (group_before.own_revision != group.own_revision
+          || group_before.own_bounds != group.own_bounds)
+      {
+        add_damage(group_before.own_bounds);
+        add_damage(group.own_bounds);
+      }
+      groups_before.erase(it);
+    }
+  }
+
+  // the remaining groups have been removed.
+  for (const auto& item : groups_before) {
+    add_damage(item.second->own_bounds);
+  }
+  return damage;
+}
+
+std::size_t DisplayList::replay(Painter& renderer) const
+{
+  const QTransform base = renderer.painter->transform();
+  const bool cull = !renderer.viewport_rect.isEmpty() && base.isInvertible();
+  QRectF visible_rect;
+  if (cull) {
+    // cosmetic pens are not covered by the bounds.
+    const QRectF rect = renderer.viewport_rect.adjusted(-CULL_MARGIN, -CULL_MARGIN,
+                                                        CULL_MARGIN, CULL_MARGIN);
+    visible_rect = base.inverted().mapRect(rect);
+  }
+
+  std::size_t n_culled = 0;
+  std::size_t command = 0;
+  for (std::size_t i = 0; i < m_groups.size(); ) {
+    const Group& group = m_groups[i];
+    replay(renderer, base, command, group.begin_command);
+    const bool is_empty = group.begin_command == group.end_command;
+    if (cull && !is_empty && !overlap(group.bounds, visible_rect)) {
+      n_culled += group.end_group - i;
+      command = group.end_command;
+      i = group.end_group;
+    } else if (!is_empty && replay_from_cache(renderer, base, group)) {
+      command = group.end_command;
+      i = group.end_group;
+    } else {
+      command = group.begin_command;
+      i += 1;
+    }
+  }
+  replay(renderer, base, command, m_commands.size());
+  renderer.painter->setTransform(base, false);
+  return n_culled;
+}
+
+void DisplayList::replay(Painter& renderer, const QTransform& base,
+                         const std::size_t begin, const std::size_t end) const
+{
+  QPainter& painter = *renderer.painter;
+  std::size_t current_transformation = m_transformations.size();
+  std::size_t current_paint = m_paints.size();
+  double tolerance = 0.0;
+  for (std::size_t i = begin; i < end; ++i) {
+    const Command& command = m_commands[i];
+    if (command.transformation != current_transformation) {
+      current_transformation = command.transformation;
+      const QTransform transformation = m_transformations[current_transformation] * base;
+      painter.setTransform(transformation, false);
+      const double scale = std::sqrt(std::abs(transformation.determinant()));
+      tolerance = scale > 0.0 ? renderer.device_tolerance / scale : 0.0;
+    }
+    if (command.paint != current_paint) {
+      current_paint = command.paint;
+      painter.setPen(m_paints[current_paint].pen);
+      painter.setBrush(m_paints[current_paint].brush);
+    }
+    replay(renderer, command, tolerance);
+  }
+}
+
+bool DisplayList::replay_from_cache(Painter& renderer, const QTransform& base,
+                                    const Group& group) const
+{
+  RasterCache* cache = renderer.raster_cache;
+  if (cache == nullptr || group.key == nullptr || !group.is_expensive) {
+    return false;
+  }
+
+  const QRectF bounds = base.mapRect(group.bounds);
+  const QRectF& viewport = renderer.viewport_rect;
+  const double max_area = MAX_RELATIVE_RASTER_AREA * viewport.width() * viewport.height();
+  if (bounds.isEmpty() || bounds.width() * bounds.height() > max_area) {
+    // rasterizing huge groups to show a small part of them isn't worth it.
+    return false;
+  }
+  // leave some space for anti-aliasing and cosmetic pens.
+  const QRect rect = bounds.toAlignedRect().adjusted(-1, -1, 1, 1);
+
+  QPainter& painter = *renderer.painter;
+  bool should_rasterize = false;
+  const QPixmap* pixmap = cache->find(group.key, group.revision, base, should_rasterize);
+  if (pixmap == nullptr && should_rasterize && !renderer.draft_quality) {
+    const double pixel_ratio = painter.device()->devicePixelRatioF();
+    QPixmap raster(rect.size() * pixel_ratio);
+    raster.setDevicePixelRatio(pixel_ratio);
+    raster.fill(Qt::transparent);
+    {
+      QPainter raster_painter(&raster);
+      raster_painter.setRenderHints(painter.renderHints());
+      const QTransform raster_base = base * QTransform::fromTranslate(-rect.left(), -rect.top());
+      QPainter* const target_painter = renderer.painter;
+      const std::size_t n_placeholders = renderer.n_placeholders();
+      const bool record_placeholder_regions = renderer.record_placeholder_regions;
+      renderer.painter = &raster_painter;
+      renderer.record_placeholder_regions = false;
+      replay(renderer, raster_base, group.begin_command, group.end_command);
+      renderer.painter = target_painter;
+      renderer.record_placeholder_regions = record_placeholder_regions;
+      if (renderer.n_placeholders() != n_placeholders) {
+        // some images are not decoded yet, the raster would be outdated soon. The group is
+        // drawn directly instead, which records the regions of the placeholders.
+        return false;
+      }
+    }
+    cache->insert(group.key, group.revision, base, raster);
+    pixmap = cache->find(group.key, group.revision, base, should_rasterize);
+  }
+
+  if (pixmap == nullptr) {
+    return false;
+  } else {
+    painter.setTransform(QTransform(), false);
+    painter.drawPixmap(rect.topLeft(), *pixmap);
+    return true;
+  }
+}
+
+void DisplayList::replay(Painter& renderer, const Command& command, const double tolerance) const
+{
+  QPainter& painter = *renderer.painter;
+  switch (command.kind) {
+  case Kind::Path:
+    painter.drawPath(m_paths[command.item]->painter_path(tolerance));
+    break;
+  case Kind::Text:
+  {
+    const Text& text = m_texts[command.item];
+    painter.setFont(text.font);
+    painter.drawStaticText(text.pos, text.text);
+    break;
+  }
+  case Kind::Image:
+  {
+    const Image& image = m_images[command.item];
+    if (image.height) {
+      renderer.draw_image(image.filename, image.pos, Vec2f(image.width, *image.height),
+                          image.opacity);
+    } else {
+      renderer.draw_image(image.filename, image.pos, image.width, image.opacity);
+    }
+    break;
+  }
+  }
+}
+
+std::size_t DisplayList::size() const { return m_commands.size(); }
+bool DisplayList::empty() const { return m_commands.empty(); }
+
+std::size_t DisplayList::add_transformation(const QTransform& transformation)
+{
+  if (m_transformations.empty() || m_transformations.back() != transformation) {
+    m_transformations.push_back(transformation);
+  }
+  return m_transformations.size() - 1;
+}
+
+std::size_t DisplayList::add_paint(const Paint& paint)
+{
+  if (m_paints.empty() || !(m_paints.back() == paint)) {
+    m_paints.push_back(paint);
+  }
+  return m_paints.size() - 1;
+}
+
+}  // namespace omm
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <map>
+#include <QBrush>
+#include <QFont>
+#include <QPen>
+#include <QRectF>
+#include <QStaticText>
+#include <QTransform>
+#include "geometry/vec2.h"
+
+namespace omm
+{
+
+class Cubics;
+class Painter;
+
+/**
+ * @brief The DisplayList class is a retained list of draw commands.
+ *  The commands, their transformations, pens and brushes are kept in flat arrays. Paths are
+ *  referenced (not copied) and their level of detail is chosen when the list is replayed.
+ *  Lists are recorded by a Painter whose `display_list` is set and concatenated with `append`.
+ *  Every command knows its bounds. Groups of commands (i.e., the objects of a subtree) can be
+ *  skipped as a whole when they are outside the viewport.
+ */
+class DisplayList
+{
+public:
+  struct Paint
+  {
+    QPen pen;
+    QBrush brush;
+    bool operator==(const Paint& other) const;
+  };
+
+  struct Text
+  {
+    QStaticText text;  // see `TextLayoutCache`
+    QFont font;
+    QPointF pos;
+  };
+
+  struct Image
+  {
+    std::string filename;
+    Vec2f pos;
+    double width;
+    std::optional<double> height;  // keep the aspect ratio of the image if not set.
+    double opacity;
+  };
+
+  void add_path(const QTransform& transformation, const Paint& paint,
+                std::shared_ptr<const Cubics> cubics);
+  void add_text(const QTransform& transformation, const Paint& paint, Text text);
+  void add_image(const QTransform& transformation, Image image);
+
+  /**
+   * @brief appends the commands of `other`, whose coordinate system is mapped to the one of this
+   *  list by `transformation`.
+   */
+  void append(const DisplayList& other, const QTransform& transformation);
+
+  /**
+   * @brief like `append`, but drops the groups of `other`, i.e., its commands become commands of
+   *  the currently open group. This allows to append the same list several times.
+   */
+  void append_commands(const DisplayList& other, const QTransform& transformation);
+
+  /**
+   * @brief opens a group which contains all commands and groups added until `end_group` is
+   *  called with the returned index. Groups must be nested properly.
+   * @param key identifies the group in the `RasterCache` across lists. The group is never
+   *  rasterized if it is nullptr.
+   */
+  std::size_t begin_group(const void* key = nullptr);
+
+  /**
+   * @param own_revision must change whenever the commands of the group which are not part of a
+   *  nested group change.
+   * @param revision must change whenever the content of the group changes.
+   */
+  void end_group(const std::size_t index, const std::size_t own_revision = 0,
+                 const std::size_t revision = 0);
+
+  /**
+   * @brief returns the regions which may look different if `after` is drawn instead of
+   *  `before`. The groups are matched by their keys, only their own commands are compared.
+   */
+  static std::vector<QRectF> damage(const DisplayList& before, const DisplayList& after);
+
+  /**
+   * @brief draws all commands with the current transformation of `renderer` as base.
+   *  Groups which are outside `renderer.viewport_rect` are skipped.
+   *  Expensive groups are drawn from `renderer.raster_cache` if possible.
+   * @return the number of skipped groups, including nested ones.
+   */
+  std::size_t replay(Painter& renderer) const;
+
+  std::size_t size() const;
+  bool empty() const;
+
+private:
+  enum class Kind { Path, Text, Image };
+  struct Command
+  {
+    Kind kind;
+    std::size_t transformation;
+    std::size_t paint;
+    std::size_t item;  // index into m_paths, m_texts or m_images, depending on `kind`.
+    QRectF bounds;
+  };
+
+  struct Group
+  {
+    std::size_t begin_command;
+    std::size_t end_command;
+    std::size_t end_group;  // the index of the group after the last nested group.
+    QRectF bounds;
+    const void* key;
+    std::size_t revision;
+    bool is_expensive;  // i.e., worth to be rasterized.
+
+    // refer to the commands which are not part of a nested group.
+    QRectF own_bounds;
+    std::size_t own_revision;
+  };
+
+  std::vector<Command> m_commands;
+  std::vector<Group> m_groups;
+  std::vector<QTransform> m_transformations;
+  std::vector<Paint> m_paints;
+  std::vector<std::shared_ptr<const Cubics>> m_paths;
+  std::vector<Text> m_texts;
+  std::vector<Image> m_images;
+
+  std::size_t add_transformation(const QTransform& transformation);
+  std::size_t add_paint(const Paint& paint);
+  void replay(Painter& renderer, const QTransform& base,
+              const std::size_t begin, const std::size_t end) const;
+  void replay(Painter& renderer, const Command& command, const double tolerance) const;
+  bool replay_from_cache(Painter& renderer, const QTransform& base, const Group& group) const;
+  void add_command(const Kind kind, const QTransform& transformation, const Paint& paint,
+                   const std::size_t item, const QRectF& bounds);
+};
+
+}  // namespace omm
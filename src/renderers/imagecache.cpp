@@ -1,17 +1,178 @@
 #include "renderers/imagecache.h"
+#include "scene/workstealingpool.h"
+
+namespace
+{
+
+std::vector<QImage> make_levels(const QImage& image)
+{
+  std::vector<QImage> levels { image };
+  while (levels.back().width() > 1 && levels.back().height() > 1) {
+    const QImage& level = levels.back();
+    levels.push_back(level.scaled(level.size() / 2, Qt::IgnoreAspectRatio,
+                                  Qt::SmoothTransformation));
+  }
+  return levels;
+}
+
+std::size_t size_in_bytes(const std::vector<QImage>& levels)
+{
+  std::size_t size = 0;
+  for (const QImage& level : levels) {
+    size += static_cast<std::size_t>(level.sizeInBytes());
+  }
+  return size;
+}
+
+}  // namespace
 
 namespace omm
 {
 
+ImageCache::ImageCache(const std::size_t budget) : m_budget(budget) {}
+
+ImageCache::~ImageCache()
+{
+  // the decoding threads must not notify m_notifier after it has been destroyed.
+  m_pool.reset();
+}
+
 QImage ImageCache::load(const std::string& filename)
 {
-  if (m_cache.count(filename) == 0) { m_cache[filename].load(QString::fromStdString(filename)); }
-  return m_cache.at(filename);
+  return load(filename, QSizeF());
+}
+
+QImage ImageCache::load(const std::string& filename, const QSizeF& size)
+{
+  if (m_pending.count(filename) > 0) {
+    wait();
+  }
+  return select_level(find(filename).levels, size);
+}
+
+std::optional<QSize> ImageCache::image_size(const std::string& filename) const
+{
+  if (const auto it = m_index.find(filename); it != m_index.end()) {
+    return it->second->levels.front().size();
+  } else {
+    return std::nullopt;
+  }
+}
+
+std::optional<QImage> ImageCache::try_load(const std::string& filename, const QSizeF& size)
+{
+  collect_decoded();
+  if (m_index.count(filename) > 0) {
+    return select_level(find(filename).levels, size);
+  } else if (m_pending.count(filename) == 0) {
+    m_statistics.misses += 1;
+    m_pending.insert(filename);
+    if (m_pool == nullptr) {
+      m_pool = std::make_unique<WorkStealingPool>(N_DECODING_THREADS);
+    }
+    m_pool->submit([this, filename]() {
+      auto levels = make_levels(QImage(QString::fromStdString(filename)));
+      {
+        std::lock_guard<std::mutex> lock(m_decoded_mutex);
+        m_decoded.emplace_back(filename, std::move(levels));
+      }
+      QMetaObject::invokeMethod(&m_notifier, [this]() { collect_decoded(); },
+                                Qt::QueuedConnection);
+    });
+  }
+  return std::nullopt;
+}
+
+void ImageCache::wait()
+{
+  if (m_pool != nullptr) {
+    m_pool->wait();
+  }
+  collect_decoded();
 }
 
 void ImageCache::clear()
 {
-  m_cache.clear();
+  m_entries.clear();
+  m_index.clear();
+  m_size = 0;
+}
+
+void ImageCache::set_budget(const std::size_t budget)
+{
+  m_budget = budget;
+  evict();
+}
+
+std::size_t ImageCache::budget() const { return m_budget; }
+std::size_t ImageCache::size() const { return m_size; }
+const ImageCache::Statistics& ImageCache::statistics() const { return m_statistics; }
+
+const ImageCache::Entry& ImageCache::find(const std::string& filename)
+{
+  if (const auto it = m_index.find(filename); it != m_index.end()) {
+    m_statistics.hits += 1;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+  } else {
+    m_statistics.misses += 1;
+
+    // images which cannot be loaded are cached, too. They are null and occupy no memory.
+    insert(filename, make_levels(QImage(QString::fromStdString(filename))));
+  }
+  return m_entries.front();
+}
+
+void ImageCache::insert(const std::string& filename, std::vector<QImage> levels)
+{
+  const std::size_t size = size_in_bytes(levels);
+  m_entries.push_front({ filename, std::move(levels), size });
+  m_index[filename] = m_entries.begin();
+  m_size += size;
+  evict();
+}
+
+QImage ImageCache::select_level(const std::vector<QImage>& levels, const QSizeF& size)
+{
+  if (!size.isValid()) {
+    return levels.front();
+  }
+  for (auto it = levels.rbegin(); it != levels.rend(); ++it) {
+    if (it->width() >= size.width() && it->height() >= size.height()) {
+      return *it;
+    }
+  }
+  return levels.front();
+}
+
+void ImageCache::collect_decoded()
+{
+  std::vector<std::pair<std::string, std::vector<QImage>>> decoded;
+  {
+    std::lock_guard<std::mutex> lock(m_decoded_mutex);
+    decoded.swap(m_decoded);
+  }
+
+  for (auto& [filename, levels] : decoded) {
+    m_pending.erase(filename);
+    if (m_index.count(filename) == 0) {
+      insert(filename, std::move(levels));
+    }
+    if (on_loaded) {
+      on_loaded(filename);
+    }
+  }
+}
+
+void ImageCache::evict()
+{
+  // the most recently used image is kept even if it exceeds the budget on its own.
+  while (m_entries.size() > 1 && m_size > m_budget) {
+    const Entry& entry = m_entries.back();
+    m_size -= entry.size;
+    m_index.erase(entry.filename);
+    m_entries.pop_back();
+    m_statistics.evictions += 1;
+  }
 }
 
 }  // namespace omm
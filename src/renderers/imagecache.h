@@ -1,18 +1,126 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
 #include <QImage>
+#include <QObject>
+#include <QSizeF>
 
 namespace omm
 {
 
+class WorkStealingPool;
+
+/**
+ * @brief The ImageCache class keeps loaded images together with their mipmaps, i.e., copies
+ *  which are repeatedly downscaled by a factor of two. The least recently used images are
+ *  dropped if the cache exceeds its budget.
+ *  Images can be decoded synchronously (`load`) or on background threads (`try_load`).
+ *  The cache must only be used from the thread which created it.
+ */
 class ImageCache
 {
 public:
+  explicit ImageCache(const std::size_t budget = DEFAULT_BUDGET);
+  ~ImageCache();
+  ImageCache(const ImageCache&) = delete;
+  ImageCache& operator=(const ImageCache&) = delete;
+
+  /**
+   * @brief returns the image in full resolution.
+   *  Decodes the image if required and waits if it is being decoded in the background.
+   */
   QImage load(const std::string& filename);
+
+  /**
+   * @brief returns the smallest mip level which is at least as large as `size` (in pixels).
+   *  Returns the image in full resolution if it is smaller than `size` or if `size` is invalid.
+   */
+  QImage load(const std::string& filename, const QSizeF& size);
+
+  /**
+   * @brief like `load`, but returns nothing if the image has not been decoded yet.
+   *  The image is decoded in the background then and `on_loaded` is called when it's done.
+   */
+  std::optional<QImage> try_load(const std::string& filename, const QSizeF& size = QSizeF());
+
+  /**
+   * @brief returns the size of the image in full resolution if it has been decoded already.
+   *  Neither decodes the image nor counts as a use of it.
+   */
+  std::optional<QSize> image_size(const std::string& filename) const;
+
+  /**
+   * @brief blocks until all images which are decoded in the background are available.
+   */
+  void wait();
+
+  /**
+   * @brief is called (in the thread of the cache) when an image which has been decoded in the
+   *  background becomes available.
+   */
+  std::function<void(const std::string& filename)> on_loaded;
+
   void clear();
 
+  void set_budget(const std::size_t budget);
+  std::size_t budget() const;
+
+  /**
+   * @brief returns the memory occupied by the images in bytes.
+   */
+  std::size_t size() const;
+
+  struct Statistics
+  {
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t evictions = 0;
+  };
+  const Statistics& statistics() const;
+
+  static constexpr std::size_t DEFAULT_BUDGET = std::size_t(512) << 20;
+
 private:
-  std::map<std::string, QImage> m_cache;
+  struct Entry
+  {
+    std::string filename;
+    std::vector<QImage> levels;  // level 0 is the image in full resolution.
+    std::size_t size;
+  };
+
+  // most recently used first.
+  std::list<Entry> m_entries;
+  std::map<std::string, std::list<Entry>::iterator> m_index;
+  std::size_t m_budget;
+  std::size_t m_size = 0;
+  Statistics m_statistics;
+
+  const Entry& find(const std::string& filename);
+  void insert(const std::string& filename, std::vector<QImage> levels);
+  void evict();
+  static QImage select_level(const std::vector<QImage>& levels, const QSizeF& size);
+
+  // background decoding
+  std::set<std::string> m_pending;
+  std::mutex m_decoded_mutex;
+  std::vector<std::pair<std::string, std::vector<QImage>>> m_decoded;
+  QObject m_notifier;  // receives the notifications of the decoding threads.
+  std::unique_ptr<WorkStealingPool> m_pool;
+  static constexpr std::size_t N_DECODING_THREADS = 2;
+
+  /**
+   * @brief moves the images which have been decoded in the background into the cache.
+   */
+  void collect_decoded();
 };
 
-}  // namespace
+}  // namespace omm
@@ -1,16 +1,24 @@
 #include "renderers/painter.h"
 #include "geometry/util.h"
 #include "scene/scene.h"
+#include "geometry/cubics.h"
+#include "objects/object.h"
+#include <QPaintEngine>
 
 namespace
 {
 
-QTransform to_transformation(const omm::ObjectTransformation& transformation)
+bool is_raster_device(QPainter& painter)
 {
-  const auto& m = transformation.to_mat();
-  return QTransform( m.m[0][0], m.m[1][0], m.m[2][0],
-                     m.m[0][1], m.m[1][1], m.m[2][1],
-                     m.m[0][2], m.m[1][2], m.m[2][2] );
+  switch (painter.paintEngine()->type()) {
+  case QPaintEngine::Picture:
+  case QPaintEngine::SVG:
+  case QPaintEngine::Pdf:
+  case QPaintEngine::PostScript:
+    return false;
+  default:
+    return true;
+  }
 }
 
 }  // namespace
@@ -26,20 +34,37 @@ omm::Painter::Painter(omm::Scene &scene, omm::Painter::Category filter)
 
 void Painter::render()
 {
-  scene.object_tree.root().draw_recursive(*this, scene.default_style());
+  Object& root = scene.object_tree.root();
+  if (!!(category_filter & Category::Objects)) {
+    push_transformation(root.transformation());
+    n_culled_objects = scene.display_list().replay(*this);
+    pop_transformation();
+  }
+
+  // the objects have been drawn already, draw only handles and bounding boxes.
+  const Category filter = category_filter;
+  category_filter = filter & ~Category::Objects;
+  if (category_filter != Category::None) {
+    root.draw_recursive(*this, scene.default_style());
+  }
+  category_filter = filter;
   assert(m_transformation_stack.empty());
 }
 
 void Painter::push_transformation(const ObjectTransformation &transformation)
 {
   m_transformation_stack.push(current_transformation().apply(transformation));
-  painter->setTransform(to_transformation(current_transformation()), false);
+  if (painter != nullptr) {
+    painter->setTransform(to_qtransform(current_transformation()), false);
+  }
 }
 
 void Painter::pop_transformation()
 {
   m_transformation_stack.pop();
-  painter->setTransform(to_transformation(current_transformation()), false);
+  if (painter != nullptr) {
+    painter->setTransform(to_qtransform(current_transformation()), false);
+  }
 }
 
 ObjectTransformation Painter::current_transformation() const
@@ -51,36 +76,73 @@ ObjectTransformation Painter::current_transformation() const
   }
 }
 
-void Painter::draw_text(const std::string &text, const Painter::TextOptions &options)
+double Painter::tolerance() const
 {
-  painter->setFont(options.font);
-  painter->setPen(make_pen(options.style));
+  // shearing and rotation do not change the area, hence the determinant is that of the scaling.
+  const Vec2f scaling = current_transformation().scaling();
+  const double scale = std::sqrt(std::abs(scaling.x * scaling.y));
+  return scale > 0.0 ? device_tolerance / scale : 0.0;
+}
 
-  static constexpr double HUGE_NUMBER = 10e10;
+void Painter::draw_path(std::shared_ptr<const Cubics> cubics)
+{
+  if (display_list != nullptr) {
+    display_list->add_path(to_qtransform(current_transformation()), m_paint,
+                           std::move(cubics));
+  } else {
+    painter->drawPath(cubics->painter_path(tolerance()));
+  }
+}
 
-  const auto [left, width] = [&options]() {
+void Painter::draw_text(const std::string &text, const Painter::TextOptions &options)
+{
+  const QStaticText static_text = scene.text_layout_cache.layout(QString::fromStdString(text),
+                                                                 options.font, options.option,
+                                                                 options.width);
+  const QSizeF size = static_text.size();
+  const double left = [&options]() {
     switch (options.option.alignment() & Qt::AlignHorizontal_Mask) {
     case Qt::AlignLeft: [[fallthrough]];
-    case Qt::AlignJustify: return std::pair(0.0, options.width);
-    case Qt::AlignHCenter: return std::pair(-options.width/2.0, options.width);
-    case Qt::AlignRight: return std::pair(-options.width, options.width);
-    default: assert(false); return std::pair(0.0, 0.0);
+    case Qt::AlignJustify: return 0.0;
+    case Qt::AlignHCenter: return -options.width/2.0;
+    case Qt::AlignRight: return -options.width;
+    default: assert(false); return 0.0;
     }
   }();
 
-  const auto [top, height] = [&options]() {
+  const double top = [&options, size]() {
     switch (options.option.alignment() & Qt::AlignVertical_Mask) {
-    case Qt::AlignTop: return std::pair(0.0, HUGE_NUMBER);
-    case Qt::AlignVCenter: return std::pair(-HUGE_NUMBER/2.0, HUGE_NUMBER);
-    case Qt::AlignBottom: return std::pair(-HUGE_NUMBER, HUGE_NUMBER);
+    case Qt::AlignTop: return 0.0;
+    case Qt::AlignVCenter: return -size.height()/2.0;
+    case Qt::AlignBottom: return -size.height();
     // Qt::AlignBaseline is never reached (see @FontProperties::code make_properties)
     case Qt::AlignBaseline:
-    default: assert(false); return std::pair(0.0, 0.0);
+    default: assert(false); return 0.0;
     }
   }();
 
-  const QRectF rect(QPointF(left, top), QSizeF(width, height));
-  painter->drawText(rect, QString::fromStdString(text), options.option);
+  const QPointF pos(left, top);
+  if (display_list != nullptr) {
+    const DisplayList::Paint paint { make_pen(options.style), QBrush(Qt::NoBrush) };
+    display_list->add_text(to_qtransform(current_transformation()), paint,
+                           { static_text, options.font, pos });
+  } else {
+    painter->setFont(options.font);
+    painter->setPen(make_pen(options.style));
+    painter->drawStaticText(pos, static_text);
+  }
+}
+
+void Painter::draw_display_list(const DisplayList& list)
+{
+  if (display_list != nullptr) {
+    display_list->append_commands(list, to_qtransform(current_transformation()));
+  } else {
+    // the list is replayed relative to the current transformation.
+    DisplayList commands;
+    commands.append_commands(list, QTransform());
+    commands.replay(*this);
+  }
 }
 
 void Painter::toast(const Vec2f &pos, const std::string &text)
@@ -109,20 +171,89 @@ void Painter::toast(const Vec2f &pos, const std::string &text)
 void Painter::draw_image(const std::string &filename, const Vec2f &pos, const Vec2f &size,
                          const double opacity)
 {
-  painter->setOpacity(opacity);
-  QRectF rect(to_qpoint(pos), to_qpoint(pos + size));
-  painter->drawImage(rect, m_image_cache.load(filename));
-  painter->setOpacity(1.0);
+  if (display_list != nullptr) {
+    display_list->add_image(to_qtransform(current_transformation()),
+                            { filename, pos, size.x, size.y, opacity });
+    return;
+  }
+  const QRectF rect(to_qpoint(pos), to_qpoint(pos + size));
+  if (const auto image = load_image(filename, rect); image) {
+    painter->setOpacity(opacity);
+    painter->drawImage(rect, *image);
+    painter->setOpacity(1.0);
+  } else {
+    draw_placeholder(filename, rect, painter->transform().mapRect(rect).toAlignedRect());
+  }
 }
 
 void Painter::draw_image(const std::string &filename, const Vec2f &pos, const double width,
                          const double opacity)
 {
-  const QImage image = m_image_cache.load(filename);
-  const auto height = static_cast<double>(width) / image.width() * image.height();
-  return draw_image(filename, pos, Vec2f{ width, height }, opacity);
+  if (display_list != nullptr) {
+    // the image is loaded when the list is replayed. If it has not been decoded yet, its height
+    // is unknown and the list is recorded again once it is, see `Scene::on_image_loaded`.
+    std::optional<double> height;
+    if (const auto size = scene.image_cache.image_size(filename); size && !size->isEmpty()) {
+      height = width / size->width() * size->height();
+    }
+    display_list->add_image(to_qtransform(current_transformation()),
+                            { filename, pos, width, height, opacity });
+    return;
+  }
+  const auto image = async_image_decoding ? scene.image_cache.try_load(filename)
+                                          : scene.image_cache.load(filename);
+  if (image) {
+    const auto height = static_cast<double>(width) / image->width() * image->height();
+    draw_image(filename, pos, Vec2f{ width, height }, opacity);
+  } else {
+    // the size of the image is not known yet, it may cover anything.
+    const QRectF rect(to_qpoint(pos), QSizeF(width, width));
+    draw_placeholder(filename, rect, viewport_rect.toAlignedRect());
+  }
+}
+
+std::optional<QImage> Painter::load_image(const std::string& filename, const QRectF& rect)
+{
+  if (!is_raster_device(*painter)) {
+    // the resolution of the target is unknown.
+    return scene.image_cache.load(filename);
+  }
+
+  // the image is drawn in the resolution of the nearest mip level which is not too small.
+  const double pixel_ratio = painter->device()->devicePixelRatioF();
+  const QSizeF device_size = painter->transform().mapRect(rect).size() * pixel_ratio;
+  if (async_image_decoding) {
+    return scene.image_cache.try_load(filename, device_size);
+  } else {
+    return scene.image_cache.load(filename, device_size);
+  }
+}
+
+void Painter::draw_placeholder(const std::string& filename, const QRectF& rect,
+                               const QRect& region)
+{
+  static const QColor color(128, 128, 128, 64);
+  painter->fillRect(rect, color);
+  if (record_placeholder_regions) {
+    m_placeholder_regions[filename] |= region;
+  }
+  m_n_placeholders += 1;
+}
+
+QRegion Painter::take_placeholder_region(const std::string& filename)
+{
+  const auto it = m_placeholder_regions.find(filename);
+  if (it == m_placeholder_regions.end()) {
+    return QRegion();
+  } else {
+    const QRegion region = it->second;
+    m_placeholder_regions.erase(it);
+    return region;
+  }
 }
 
+std::size_t Painter::n_placeholders() const { return m_n_placeholders; }
+
 QPainterPath Painter::path(const std::vector<Point> &points, bool closed)
 {
   QPainterPath path;
@@ -146,28 +277,15 @@ QPainterPath Painter::path(const std::vector<Point> &points, bool closed)
   return path;
 }
 
-QBrush Painter::make_brush(const Style &style)
-{
-  if (style.property(omm::Style::BRUSH_IS_ACTIVE_KEY)->value<bool>()) {
-    QBrush brush(Qt::SolidPattern);
-    const auto color = style.property(omm::Style::BRUSH_COLOR_KEY)->value<omm::Color>();
-    brush.setColor(to_qcolor(color));
-    return brush;
-  } else {
-    return QBrush(Qt::NoBrush);
-  }
-}
+QBrush Painter::make_brush(const Style &style) { return style.brush(); }
+QPen Painter::make_pen(const Style &style) { return style.pen(); }
 
-QPen Painter::make_pen(const Style &style)
+QTransform Painter::to_qtransform(const ObjectTransformation& transformation)
 {
-  if (style.property(omm::Style::PEN_IS_ACTIVE_KEY)->value<bool>()) {
-    QPen pen;
-    pen.setWidthF(style.property(omm::Style::PEN_WIDTH_KEY)->value<double>());
-    pen.setColor(to_qcolor(style.property(omm::Style::PEN_COLOR_KEY)->value<omm::Color>()));
-    return pen;
-  } else {
-    return QPen(Qt::NoPen);
-  }
+  const auto& m = transformation.to_mat();
+  return QTransform( m.m[0][0], m.m[1][0], m.m[2][0],
+                     m.m[0][1], m.m[1][1], m.m[2][1],
+                     m.m[0][2], m.m[1][2], m.m[2][2] );
 }
 
 QColor Painter::to_qcolor(Color color)
@@ -181,8 +299,12 @@ QColor Painter::to_qcolor(Color color)
 
 void Painter::set_style(const Style &style)
 {
-  painter->setPen(make_pen(style));
-  painter->setBrush(make_brush(style));
+  if (display_list != nullptr) {
+    m_paint = { style.pen(), style.brush() };
+  } else {
+    painter->setPen(style.pen());
+    painter->setBrush(style.brush());
+  }
 }
 
 }  // namespace omm
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <map>
+#include <optional>
 #include <string>
 #include <stack>
 
@@ -9,7 +11,8 @@
 #include "common.h"
 #include <QPainter>
 #include <QPainterPath>
-#include "renderers/imagecache.h"
+#include <QRegion>
+#include "renderers/displaylist.h"
 #include "color/color.h"
 
 class QFont;
@@ -21,6 +24,8 @@ namespace omm
 class Style;
 class Scene;
 class Rectangle;
+class Cubics;
+class RasterCache;
 
 class Painter
 {
@@ -39,13 +44,31 @@ public:
   enum class Category { None = 0x0, Objects = 0x1, Handles = 0x2, BoundingBox = 0x4,
                         All = Objects | Handles | BoundingBox };
   explicit Painter(Scene& scene, Category filter);
+
+  /**
+   * @brief replays the display list of the scene and draws the handles and bounding boxes
+   *  if requested by the category filter.
+   */
   void render();
 
   void push_transformation(const ObjectTransformation& transformation);
   void pop_transformation();
   ObjectTransformation current_transformation() const;
 
+  /**
+   * @brief returns `device_tolerance` in the coordinate system of the current transformation.
+   *  Curves may be approximated that coarsely when they are drawn (level of detail).
+   */
+  double tolerance() const;
+
+  void draw_path(std::shared_ptr<const Cubics> cubics);
   void draw_text(const std::string& text, const TextOptions& options);
+
+  /**
+   * @brief draws the commands of `list` with the current transformation.
+   *  The groups of `list` are dropped (see `DisplayList::append_commands`).
+   */
+  void draw_display_list(const DisplayList& list);
   void toast(const Vec2f& pos, const std::string& text);
 
   void draw_image( const std::string& filename, const Vec2f& pos, const Vec2f& size,
@@ -57,16 +80,85 @@ public:
   static QBrush make_brush(const Style& style);
   static QPen make_pen(const Style& style);
   static QColor to_qcolor(Color color);
+  static QTransform to_qtransform(const ObjectTransformation& transformation);
 
   void set_style(const Style& style);
 
+  /**
+   * @brief returns the region (in device coordinates) which has been covered by placeholders
+   *  for `filename` and forgets about it.
+   */
+  QRegion take_placeholder_region(const std::string& filename);
+
   Scene& scene;
   Category category_filter;
   QPainter* painter = nullptr;
 
+  /**
+   * @brief the maximal deviation of drawn curves in device pixels.
+   *  Zero means that curves are drawn exactly, e.g., for export.
+   */
+  double device_tolerance = 0.0;
+
+  /**
+   * @brief if set, the draw calls are recorded into this list rather than painted.
+   *  `painter` is not used then.
+   */
+  DisplayList* display_list = nullptr;
+
+  /**
+   * @brief objects outside of this rectangle (in device coordinates) are not drawn by `render`.
+   *  Nothing is culled if the rectangle is empty.
+   */
+  QRectF viewport_rect;
+
+  /**
+   * @brief the number of objects which have been culled by the last call of `render`.
+   */
+  std::size_t n_culled_objects = 0;
+
+  /**
+   * @brief if set, `render` draws unchanged expensive subtrees from this cache.
+   */
+  RasterCache* raster_cache = nullptr;
+
+  /**
+   * @brief whether the frame is rendered in draft quality. Cached rasters are reused, but no
+   *  new rasters are created then. The render hints and `device_tolerance` are set by the owner
+   *  of the painter.
+   */
+  bool draft_quality = false;
+
+  /**
+   * @brief if set, images are decoded in the background (see `ImageCache::try_load`) and a
+   *  placeholder is drawn until they are available.
+   */
+  bool async_image_decoding = false;
+
+  /**
+   * @brief the regions covered by placeholders are recorded only if set.
+   *  It must be unset while drawing into an intermediate pixmap, whose coordinates differ from
+   *  the ones of the device.
+   */
+  bool record_placeholder_regions = true;
+
+  /**
+   * @brief returns the number of placeholders drawn so far.
+   */
+  std::size_t n_placeholders() const;
+
 private:
   std::stack<ObjectTransformation> m_transformation_stack;
-  ImageCache m_image_cache;
+  std::map<std::string, QRegion> m_placeholder_regions;
+  std::size_t m_n_placeholders = 0;
+
+  /**
+   * @brief returns the image which fits best to be drawn into `rect` or nothing if the image
+   *  is not available yet.
+   */
+  std::optional<QImage> load_image(const std::string& filename, const QRectF& rect);
+  void draw_placeholder(const std::string& filename, const QRectF& rect, const QRect& region);
+  DisplayList::Paint m_paint;
 };
 
 }  // namespace omm
@@ -0,0 +1,113 @@
+#include "renderers/rastercache.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+double fractional_part(const double value)
+{
+  return value - std::floor(value);
+}
+
+bool is_close(const double a, const double b)
+{
+  static constexpr double eps = 1e-9;
+  return std::abs(a - b) < eps;
+}
+
+}  // namespace
+
+namespace omm
+{
+
+RasterCache::RasterCache(const std::size_t budget) : m_budget(budget) {}
+
+const QPixmap* RasterCache::find(const void* key, const std::size_t revision,
+                                 const QTransform& transformation, bool& should_rasterize)
+{
+  const auto it = m_index.find(key);
+  if (it == m_index.end()) {
+    m_entries.push_front({ key, { revision, transformation }, State(), QPixmap() });
+    m_index[key] = m_entries.begin();
+    evict();
+    should_rasterize = false;
+    return nullptr;
+  }
+
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  Entry& entry = *it->second;
+  if (!entry.pixmap.isNull() && entry.rasterized.matches(revision, transformation)) {
+    should_rasterize = false;
+    return &entry.pixmap;
+  } else {
+    should_rasterize = entry.requested.matches(revision, transformation);
+    entry.requested = { revision, transformation };
+    return nullptr;
+  }
+}
+
+void RasterCache::insert(const void* key, const std::size_t revision,
+                         const QTransform& transformation, const QPixmap& pixmap)
+{
+  auto it = m_index.find(key);
+  if (it == m_index.end()) {
+    m_entries.push_front({ key, State(), State(), QPixmap() });
+    it = m_index.emplace(key, m_entries.begin()).first;
+  }
+  Entry& entry = *it->second;
+  m_size -= size(entry.pixmap);
+  entry.requested = { revision, transformation };
+  entry.rasterized = { revision, transformation };
+  entry.pixmap = pixmap;
+  m_size += size(entry.pixmap);
+  evict();
+}
+
+void RasterCache::set_budget(const std::size_t budget)
+{
+  m_budget = budget;
+  evict();
+}
+
+std::size_t RasterCache::budget() const { return m_budget; }
+std::size_t RasterCache::size() const { return m_size; }
+
+void RasterCache::clear()
+{
+  m_entries.clear();
+  m_index.clear();
+  m_size = 0;
+}
+
+bool RasterCache::State::matches(const std::size_t revision,
+                                 const QTransform& transformation) const
+{
+  // the pixmap can be moved by whole pixels.
+  const QTransform& t = this->transformation;
+  return this->revision == revision
+      && t.m11() == transformation.m11() && t.m12() == transformation.m12()
+      && t.m21() == transformation.m21() && t.m22() == transformation.m22()
+      && !t.isProjecting() && !transformation.isProjecting()
+      && is_close(fractional_part(t.dx()), fractional_part(transformation.dx()))
+      && is_close(fractional_part(t.dy()), fractional_part(transformation.dy()));
+}
+
+void RasterCache::evict()
+{
+  // the most recently used entry is kept even if it exceeds the budget on its own.
+  while (m_entries.size() > 1 && (m_size > m_budget || m_entries.size() > MAX_N_ENTRIES)) {
+    const Entry& entry = m_entries.back();
+    m_size -= size(entry.pixmap);
+    m_index.erase(entry.key);
+    m_entries.pop_back();
+  }
+}
+
+std::size_t RasterCache::size(const QPixmap& pixmap)
+{
+  return static_cast<std::size_t>(pixmap.width()) * static_cast<std::size_t>(pixmap.height())
+         * static_cast<std::size_t>(std::max(1, pixmap.depth() / 8));
+}
+
+}  // namespace omm
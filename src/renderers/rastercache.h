@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <QPixmap>
+#include <QTransform>
+
+namespace omm
+{
+
+/**
+ * @brief The RasterCache class keeps rasterized subtrees of the display list.
+ *  A pixmap can be reused as long as the content of the subtree (identified by its revision)
+ *  and the zoom (i.e., the transformation without its integral translation) are unchanged.
+ *  Subtrees are rasterized only if they have been requested twice in the same state in a row,
+ *  hence they are not rasterized while they are edited or zoomed.
+ *  The least recently used pixmaps are dropped if the cache exceeds its budget.
+ */
+class RasterCache
+{
+public:
+  explicit RasterCache(const std::size_t budget);
+
+  /**
+   * @brief returns the pixmap of the subtree identified by `key` if it has been rasterized in
+   *  the given state. `transformation` maps the subtree to device coordinates.
+   *  Returns nullptr otherwise, `should_rasterize` tells whether the caller should rasterize
+   *  the subtree and `insert` it.
+   */
+  const QPixmap* find(const void* key, const std::size_t revision,
+                      const QTransform& transformation, bool& should_rasterize);
+
+  void insert(const void* key, const std::size_t revision, const QTransform& transformation,
+              const QPixmap& pixmap);
+
+  void set_budget(const std::size_t budget);
+  std::size_t budget() const;
+
+  /**
+   * @brief returns the memory occupied by the pixmaps in bytes.
+   */
+  std::size_t size() const;
+  void clear();
+
+private:
+  struct State
+  {
+    std::size_t revision = 0;
+    QTransform transformation;
+    bool matches(const std::size_t revision, const QTransform& transformation) const;
+  };
+
+  struct Entry
+  {
+    const void* key;
+    State requested;
+    State rasterized;
+    QPixmap pixmap;
+  };
+
+  // most recently used first.
+  std::list<Entry> m_entries;
+  std::map<const void*, std::list<Entry>::iterator> m_index;
+  std::size_t m_budget;
+  std::size_t m_size = 0;
+
+  // entries which have been requested but not rasterized yet don't count towards the budget.
+  static constexpr std::size_t MAX_N_ENTRIES = 10000;
+
+  void evict();
+  static std::size_t size(const QPixmap& pixmap);
+};
+
+}  // namespace omm
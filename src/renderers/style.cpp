@@ -4,12 +4,26 @@
 #include "properties/floatproperty.h"
 #include "scene/scene.h"
 #include "renderers/styleiconengine.h"
+#include "renderers/painter.h"
+#include <atomic>
+
+namespace
+{
+
+std::size_t next_revision()
+{
+  static std::atomic<std::size_t> revision = 0;
+  return ++revision;
+}
+
+}  // namespace
 
 namespace omm
 {
 
 Style::Style(Scene* scene)
   : m_scene(scene)
+  , m_revision(next_revision())
 {
   add_property<StringProperty>(NAME_PROPERTY_KEY, QObject::tr("<unnamed object>").toStdString())
     .set_label(QObject::tr("Name").toStdString())
@@ -51,6 +65,49 @@ QIcon Style::icon() const
   return QIcon(std::make_unique<StyleIconEngine>(*this).release());
 }
 
+const QPen& Style::pen() const
+{
+  resolve();
+  return m_pen;
+}
+
+const QBrush& Style::brush() const
+{
+  resolve();
+  return m_brush;
+}
+
+std::size_t Style::revision() const { return m_revision; }
+
+void Style::on_property_value_changed(Property& property, std::set<const void*> trace)
+{
+  m_revision = next_revision();
+  PropertyOwner::on_property_value_changed(property, trace);
+}
+
+void Style::resolve() const
+{
+  if (m_resolved_revision == m_revision) {
+    return;
+  }
+
+  if (property(PEN_IS_ACTIVE_KEY)->value<bool>()) {
+    m_pen = QPen();
+    m_pen.setWidthF(property(PEN_WIDTH_KEY)->value<double>());
+    m_pen.setColor(Painter::to_qcolor(property(PEN_COLOR_KEY)->value<Color>()));
+  } else {
+    m_pen = QPen(Qt::NoPen);
+  }
+
+  if (property(BRUSH_IS_ACTIVE_KEY)->value<bool>()) {
+    m_brush = QBrush(Qt::SolidPattern);
+    m_brush.setColor(Painter::to_qcolor(property(BRUSH_COLOR_KEY)->value<Color>()));
+  } else {
+    m_brush = QBrush(Qt::NoBrush);
+  }
+  m_resolved_revision = m_revision;
+}
+
 SolidStyle::SolidStyle(const Color& color, Scene* scene) : Style(scene)
 {
   property(omm::Style::PEN_IS_ACTIVE_KEY)->set(false);
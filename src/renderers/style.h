@@ -1,6 +1,8 @@
 #pragma once
 
+#include <QBrush>
 #include <QIcon>
+#include <QPen>
 #include "aspects/propertyowner.h"
 #include "color/color.h"
 
@@ -22,8 +24,30 @@ public:
   Flag flags() const override;
   Scene* scene() const;
 
+  /**
+   * @brief returns the pen and the brush described by the properties.
+   *  They are cached until a property changes.
+   */
+  const QPen& pen() const;
+  const QBrush& brush() const;
+
+  /**
+   * @brief returns a number which changes whenever a property of this style changes.
+   *  Revisions are unique among all styles.
+   */
+  std::size_t revision() const;
+
+  void on_property_value_changed(Property& property, std::set<const void*> trace) override;
+
 private:
   Scene* const m_scene;
+  std::size_t m_revision;
+
+  // pen and brush are valid if m_resolved_revision equals m_revision.
+  mutable QPen m_pen;
+  mutable QBrush m_brush;
+  mutable std::size_t m_resolved_revision = 0;
+  void resolve() const;
 
 public:
   static constexpr auto PEN_IS_ACTIVE_KEY = "pen/active";
@@ -0,0 +1,70 @@
+#include "renderers/textlayoutcache.h"
+#include <tuple>
+#include <QTransform>
+
+namespace
+{
+
+auto comparable(const QTextOption& option)
+{
+  return std::tuple(static_cast<int>(option.alignment()), static_cast<int>(option.wrapMode()),
+                    static_cast<int>(option.flags()), static_cast<int>(option.textDirection()),
+                    option.tabStopDistance(), option.useDesignMetrics());
+}
+
+}  // namespace
+
+namespace omm
+{
+
+TextLayoutCache::TextLayoutCache(const std::size_t capacity) : m_capacity(capacity) {}
+
+QStaticText TextLayoutCache::layout(const QString& text, const QFont& font,
+                                    const QTextOption& option, const double width)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Key key { text, font, option, width };
+  if (const auto it = m_index.find(key); it != m_index.end()) {
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->static_text;
+  }
+
+  QStaticText static_text(text);
+  static_text.setTextFormat(Qt::PlainText);
+  static_text.setTextOption(option);
+  static_text.setTextWidth(width);
+
+  // the layout is computed once and shared by all copies.
+  static_text.prepare(QTransform(), font);
+
+  m_entries.push_front({ std::move(key), static_text });
+  m_index.emplace(m_entries.front().key, m_entries.begin());
+  while (m_entries.size() > m_capacity) {
+    m_index.erase(m_entries.back().key);
+    m_entries.pop_back();
+  }
+  return static_text;
+}
+
+void TextLayoutCache::clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+  m_index.clear();
+}
+
+std::size_t TextLayoutCache::size() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+bool TextLayoutCache::Key::operator<(const Key& other) const
+{
+  const auto option = comparable(this->option);
+  const auto other_option = comparable(other.option);
+  return std::tie(width, option, text, font)
+       < std::tie(other.width, other_option, other.text, other.font);
+}
+
+}  // namespace omm
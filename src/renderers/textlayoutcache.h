@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+#include <QFont>
+#include <QStaticText>
+#include <QString>
+#include <QTextOption>
+
+namespace omm
+{
+
+/**
+ * @brief The TextLayoutCache class keeps laid out texts, such that unchanged texts are not laid
+ *  out again whenever they are recorded or drawn. The least recently used layouts are dropped if
+ *  the cache holds more than `capacity` layouts.
+ *  The cache can be used from any thread.
+ */
+class TextLayoutCache
+{
+public:
+  explicit TextLayoutCache(const std::size_t capacity = DEFAULT_CAPACITY);
+
+  /**
+   * @brief returns `text` laid out with `font` and `option` into lines of `width`.
+   *  The top left corner of the layout is at the origin.
+   */
+  QStaticText layout(const QString& text, const QFont& font, const QTextOption& option,
+                     const double width);
+
+  void clear();
+
+  /**
+   * @brief returns the number of cached layouts.
+   */
+  std::size_t size() const;
+
+  static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+
+private:
+  struct Key
+  {
+    QString text;
+    QFont font;
+    QTextOption option;
+    double width;
+    bool operator<(const Key& other) const;
+  };
+
+  struct Entry
+  {
+    Key key;
+    QStaticText static_text;
+  };
+
+  // most recently used first.
+  std::list<Entry> m_entries;
+  std::map<Key, std::list<Entry>::iterator> m_index;
+  const std::size_t m_capacity;
+  mutable std::mutex m_mutex;
+};
+
+}  // namespace omm
@@ -0,0 +1,278 @@
+#include "scene/dependencygraph.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include "objects/object.h"
+#include "properties/referenceproperty.h"
+#include "tags/styletag.h"
+#include "scene/workstealingpool.h"
+#include "logging.h"
+
+namespace
+{
+
+void collect_post_order(omm::Object& object, std::vector<omm::Object*>& objects)
+{
+  for (omm::Object* child : object.tree_children()) {
+    collect_post_order(*child, objects);
+  }
+  objects.push_back(&object);
+}
+
+void evaluate_tags(omm::Object& object)
+{
+  for (omm::Tag* tag : object.tags.ordered_items()) {
+    tag->evaluate();
+  }
+}
+
+bool has_evaluated_tags(const omm::Object& object)
+{
+  // evaluating a style tag does nothing.
+  const auto tags = object.tags.items();
+  return std::any_of(tags.begin(), tags.end(), [](const omm::Tag* tag) {
+    return tag->type() != omm::StyleTag::TYPE;
+  });
+}
+
+std::vector<omm::ReferenceProperty*> reference_properties(const omm::AbstractPropertyOwner& apo)
+{
+  std::vector<omm::ReferenceProperty*> properties;
+  for (omm::Property* property : apo.properties().values()) {
+    if (auto* reference_property = omm::type_cast<omm::ReferenceProperty*>(property)) {
+      properties.push_back(reference_property);
+    }
+  }
+  return properties;
+}
+
+}  // namespace
+
+namespace omm
+{
+
+DependencyGraph::DependencyGraph(Object& root) : m_root(root)
+{
+  // the post order is a valid evaluation order if there were no references.
+  std::vector<Object*> objects;
+  collect_post_order(root, objects);
+  const std::size_t n = objects.size();
+  std::unordered_map<const Object*, std::size_t> indices;
+  for (std::size_t i = 0; i < n; ++i) {
+    indices.insert({ objects[i], i });
+  }
+
+  std::vector<std::vector<std::size_t>> dependents(n);
+  std::vector<std::size_t> in_degrees(n, 0);
+  const auto add_edge = [&dependents, &in_degrees](const std::size_t from, const std::size_t to) {
+    dependents[from].push_back(to);
+    in_degrees[to] += 1;
+  };
+  const auto add_reference_edges = [&](const AbstractPropertyOwner& holder, const std::size_t i) {
+    for (ReferenceProperty* property : reference_properties(holder)) {
+      AbstractPropertyOwner* value = property->value();
+      m_references.emplace_back(property, value);
+      if (const auto it = indices.find(kind_cast<Object*>(value)); it != indices.end()) {
+        add_edge(it->second, i);
+      }
+    }
+  };
+  for (std::size_t i = 0; i < n; ++i) {
+    const Object& object = *objects[i];
+    if (!object.is_root()) {
+      add_edge(i, indices.at(&object.tree_parent()));
+    }
+    add_reference_edges(object, i);
+    for (const Tag* tag : object.tags.ordered_items()) {
+      add_reference_edges(*tag, i);
+    }
+  }
+
+  // Kahn's algorithm. Among the ready objects, prefer the one which comes first in post order
+  // to keep the evaluation order close to the hierarchy.
+  std::vector<std::size_t> positions(n, n);
+  std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<>> ready;
+  for (std::size_t i = 0; i < n; ++i) {
+    if (in_degrees[i] == 0) {
+      ready.push(i);
+    }
+  }
+  m_order.reserve(n);
+  while (!ready.empty()) {
+    const std::size_t i = ready.top();
+    ready.pop();
+    positions[i] = m_order.size();
+    m_order.push_back(objects[i]);
+    for (const std::size_t j : dependents[i]) {
+      in_degrees[j] -= 1;
+      if (in_degrees[j] == 0) {
+        ready.push(j);
+      }
+    }
+  }
+
+  if (m_order.size() < n) {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (positions[i] == n) {
+        positions[i] = m_order.size();
+        m_order.push_back(objects[i]);
+        m_cyclic.push_back(objects[i]);
+      }
+    }
+    LWARNING << "Dependency cycle detected. " << m_cyclic.size()
+             << " objects are evaluated ignoring their references.";
+  }
+
+  m_dependents.resize(n);
+  m_n_dependencies.resize(n, 0);
+  for (std::size_t i = 0; i < n; ++i) {
+    for (const std::size_t j : dependents[i]) {
+      if (positions[j] > positions[i]) {
+        m_dependents[positions[i]].push_back(positions[j]);
+        m_n_dependencies[positions[j]] += 1;
+      }
+    }
+  }
+}
+
+std::size_t DependencyGraph::evaluate() const
+{
+  std::size_t n_updates = 0;
+  std::vector<bool> is_stale(m_order.size(), false);
+  const auto update = [this, &n_updates, &is_stale](const std::size_t i) {
+    Object& object = *m_order[i];
+    if (is_stale[i] || object.is_dirty()) {
+      object.update_and_mark_clean();
+      n_updates += 1;
+      for (const std::size_t j : m_dependents[i]) {
+        is_stale[j] = true;
+      }
+    }
+  };
+
+  for (std::size_t i = 0; i < m_order.size(); ++i) {
+    evaluate_tags(*m_order[i]);
+    update(i);
+  }
+  return n_updates + update_dirty_objects();
+}
+
+std::size_t DependencyGraph::evaluate(WorkStealingPool& pool) const
+{
+  const std::size_t n = m_order.size();
+  std::atomic<std::size_t> n_updates = 0;
+  const auto is_stale = std::make_unique<std::atomic<bool>[]>(n);
+  const auto n_pending_dependencies = std::make_unique<std::atomic<std::size_t>[]>(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    is_stale[i] = false;
+    n_pending_dependencies[i] = m_n_dependencies[i];
+  }
+  std::mutex main_thread_queue_mutex;
+  std::vector<std::size_t> main_thread_queue;
+
+  const auto needs_update = [this, &is_stale](const std::size_t i) {
+    return is_stale[i] || m_order[i]->is_dirty();
+  };
+
+  // finish(i, ...) is called once i has been evaluated. It hands out the dependents of i which
+  // become ready. Clean objects are finished immediately, without leaving the current thread.
+  std::function<void(std::size_t, bool)> finish;
+  const auto schedule = [&](const std::size_t i) {
+    const Object& object = *m_order[i];
+    if (has_evaluated_tags(object) || (needs_update(i) && !object.is_update_thread_safe())) {
+      std::lock_guard<std::mutex> lock(main_thread_queue_mutex);
+      main_thread_queue.push_back(i);
+      return true;
+    } else if (needs_update(i)) {
+      pool.submit([&, i]() {
+        m_order[i]->update_and_mark_clean();
+        n_updates += 1;
+        finish(i, true);
+      });
+      return true;
+    } else {
+      return false;
+    }
+  };
+  finish = [&](const std::size_t i, const bool is_updated) {
+    std::vector<std::pair<std::size_t, bool>> stack { { i, is_updated } };
+    while (!stack.empty()) {
+      const auto [k, is_k_updated] = stack.back();
+      stack.pop_back();
+      for (const std::size_t j : m_dependents[k]) {
+        if (is_k_updated) {
+          is_stale[j] = true;
+        }
+        if (--n_pending_dependencies[j] == 0 && !schedule(j)) {
+          stack.emplace_back(j, false);
+        }
+      }
+    }
+  };
+
+  for (std::size_t i = 0; i < n; ++i) {
+    if (m_n_dependencies[i] == 0 && !schedule(i)) {
+      finish(i, false);
+    }
+  }
+
+  while (true) {
+    pool.wait();
+    std::vector<std::size_t> ready;
+    {
+      std::lock_guard<std::mutex> lock(main_thread_queue_mutex);
+      std::swap(ready, main_thread_queue);
+    }
+    if (ready.empty()) {
+      break;
+    }
+
+    // the pool is idle, hence nothing runs concurrently until the objects are finished.
+    std::vector<bool> is_updated(ready.size(), false);
+    for (std::size_t k = 0; k < ready.size(); ++k) {
+      Object& object = *m_order[ready[k]];
+      evaluate_tags(object);
+      if (needs_update(ready[k])) {
+        object.update_and_mark_clean();
+        n_updates += 1;
+        is_updated[k] = true;
+      }
+    }
+    for (std::size_t k = 0; k < ready.size(); ++k) {
+      finish(ready[k], is_updated[k]);
+    }
+  }
+  return n_updates + update_dirty_objects();
+}
+
+std::size_t DependencyGraph::update_dirty_objects() const
+{
+  std::size_t n_updates = 0;
+  std::vector<bool> is_stale(m_order.size(), false);
+  for (std::size_t i = 0; i < m_order.size(); ++i) {
+    if (is_stale[i] || m_order[i]->is_dirty()) {
+      m_order[i]->update_and_mark_clean();
+      n_updates += 1;
+      for (const std::size_t j : m_dependents[i]) {
+        is_stale[j] = true;
+      }
+    }
+  }
+  return n_updates;
+}
+
+bool DependencyGraph::is_stale() const
+{
+  return std::any_of(m_references.begin(), m_references.end(), [](const auto& reference) {
+    return reference.first->value() != reference.second;
+  });
+}
+
+const Object& DependencyGraph::root() const { return m_root; }
+const std::vector<Object*>& DependencyGraph::order() const { return m_order; }
+const std::vector<Object*>& DependencyGraph::cyclic() const { return m_cyclic; }
+
+}  // namespace omm
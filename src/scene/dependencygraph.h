@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace omm
+{
+
+class AbstractPropertyOwner;
+class Object;
+class ReferenceProperty;
+class WorkStealingPool;
+
+/**
+ * @brief The DependencyGraph class orders the objects of a tree such that every object comes
+ *  after all objects it depends on.
+ *  An object depends on its children and on the objects referenced by its own or its tags'
+ *  ReferenceProperties (e.g., the path of a Cloner or PathTag, the reference of an Outline or
+ *  the target of an Instance).
+ *  The graph must be rebuilt if the hierarchy changes or if it is stale.
+ */
+class DependencyGraph
+{
+public:
+  explicit DependencyGraph(Object& root);
+
+  /**
+   * @brief evaluates the tags of all objects and updates every dirty object and everything that
+   *  depends on it in topological order. All objects are clean afterwards.
+   * @return the number of updated objects.
+   */
+  std::size_t evaluate() const;
+
+  /**
+   * @brief like `evaluate`, but updates independent objects concurrently on the workers of
+   *  `pool`. Objects which have tags to evaluate or whose update is not thread safe (e.g.,
+   *  because it runs Python code) are evaluated on the calling thread while the pool is idle.
+   */
+  std::size_t evaluate(WorkStealingPool& pool) const;
+
+  /**
+   * @brief returns true if a reference has been changed since the graph was built.
+   */
+  bool is_stale() const;
+
+  const Object& root() const;
+
+  /**
+   * @brief returns all objects in evaluation order.
+   */
+  const std::vector<Object*>& order() const;
+
+  /**
+   * @brief returns the objects which are part of a dependency cycle or depend on one.
+   *  They come last in `order`, children first, and their references are ignored.
+   */
+  const std::vector<Object*>& cyclic() const;
+
+private:
+  Object& m_root;
+  std::vector<Object*> m_order;
+  std::vector<Object*> m_cyclic;
+
+  // m_dependents[i] are the indices of the objects which depend on m_order[i].
+  // Only objects which come after m_order[i] are listed.
+  std::vector<std::vector<std::size_t>> m_dependents;
+  std::vector<std::size_t> m_n_dependencies;
+
+  std::vector<std::pair<const ReferenceProperty*, const AbstractPropertyOwner*>> m_references;
+
+  /**
+   * @brief updates the objects which are still dirty.
+   *  Tags may have modified objects which had been evaluated before.
+   */
+  std::size_t update_dirty_objects() const;
+};
+
+}  // namespace omm
@@ -78,6 +78,7 @@ template<typename T> void List<T>::insert(ListOwningContext<T>& context)
   if constexpr (std::is_base_of_v<AbstractPropertyOwner, T>) {
     context.get_subject().register_observer(this);
   }
+  m_revision += 1;
   Q_EMIT this->structure_changed({ this });
 }
 
@@ -92,6 +93,7 @@ template<typename T> void List<T>::remove(ListOwningContext<T>& context)
     context.get_subject().unregister_observer(this);
   }
   context.subject.capture(::extract(m_items, context.subject.get()));
+  m_revision += 1;
   Q_EMIT this->structure_changed({ this });
 }
 
@@ -105,6 +107,7 @@ template<typename T> std::unique_ptr<T> List<T>::remove(T& item)
   if constexpr (std::is_base_of_v<AbstractPropertyOwner, T>) {
     item.unregister_observer(this);
   }
+  m_revision += 1;
   Q_EMIT this->structure_changed({ this });
   return extracted_item;
 }
@@ -141,6 +144,7 @@ template<typename T> void List<T>::move(ListMoveContext<T>& context)
   std::unique_ptr<T> item = ::extract(m_items, context.subject.get());
   const auto i = m_items.begin() + static_cast<int>(this->insert_position(context.predecessor));
   m_items.insert(i, std::move(item));
+  m_revision += 1;
   Q_EMIT this->structure_changed({ this });
 }
 
@@ -154,10 +158,16 @@ std::vector<std::unique_ptr<T>> List<T>::set(std::vector<std::unique_ptr<T>> ite
   auto old_items = std::move(m_items);
   m_items = std::move(items);
   register_items(m_items, *this);
+  m_revision += 1;
   Q_EMIT this->structure_changed({ this });
   return old_items;
 }
 
+template<typename T> std::size_t List<T>::revision() const
+{
+  return m_revision;
+}
+
 template<typename T> size_t List<T>::size() const
 {
   return m_items.size();
@@ -177,6 +187,7 @@ void List<T>::on_change(AbstractPropertyOwner *apo, int what, Property *property
   Q_UNUSED(apo)
   Q_UNUSED(what)
   Q_UNUSED(property)
+  m_revision += 1;
   Q_EMIT this->item_changed(trace);
 }
 
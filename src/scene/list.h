@@ -38,6 +38,12 @@ public:
   size_t position(const T& item) const override;
   size_t size() const;
 
+  /**
+   * @brief returns a number which changes whenever an item is inserted, removed, moved or
+   *  changed.
+   */
+  std::size_t revision() const;
+
   std::unique_ptr<T> remove(T& t) override;
 
   bool contains(const T& item) const;
@@ -47,6 +53,7 @@ public:
 
 private:
   std::vector<std::unique_ptr<T>> m_items;
+  std::size_t m_revision = 1;
 };
 
 }  // namespace omm
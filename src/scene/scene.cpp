@@ -6,8 +6,11 @@
 #include <QTimer>
 #include <QMessageBox>
 #include <fstream>
+#include <thread>
+#include <algorithm>
 
 #include "objects/empty.h"
+#include "objects/imageobject.h"
 #include "external/json.hpp"
 #include "properties/stringproperty.h"
 #include "properties/boolproperty.h"
@@ -20,6 +23,8 @@
 #include "commands/propertycommand.h"
 #include "commands/removecommand.h"
 #include "tools/selecttool.h"
+#include "scene/dependencygraph.h"
+#include "scene/workstealingpool.h"
 #include "logging.h"
 
 namespace
@@ -90,6 +95,9 @@ void Scene::prepare_reset()
       }
     }
   }
+  m_dependency_graph.reset();
+  m_display_list = DisplayList();
+  m_display_list_is_dirty = true;
   object_tree.replace_root(make_root());
   styles.set(std::vector<std::unique_ptr<Style>> {});
 }
@@ -159,6 +167,8 @@ Scene::find_reference_holders(const std::set<AbstractPropertyOwner*>& candidates
 void Scene::invalidate()
 {
   m_tags_cache_is_dirty = true;
+  m_dependency_graph.reset();
+  m_display_list_is_dirty = true;
   Q_EMIT structure_changed();
   set_selection(::filter_if(m_selection, [this](auto* apo) {
     return contains(apo);
@@ -371,11 +381,6 @@ template<> std::set<Style*> Scene::find_items<Style>(const std::string& name) co
   return filter_by_name(styles.items(), name);
 }
 
-void Scene::evaluate_tags()
-{
-  for (Tag* tag : tags()) { tag->evaluate(); }
-}
-
 bool Scene::can_remove( QWidget* parent, std::set<AbstractPropertyOwner*> selection,
                                          std::set<Property*>& properties ) const
 {
@@ -433,7 +438,65 @@ bool Scene::remove(QWidget* parent, const std::set<AbstractPropertyOwner*>& sele
 
 void Scene::update()
 {
-  object_tree.root().update_recursive();
+  if (m_dependency_graph == nullptr || &m_dependency_graph->root() != &object_tree.root()
+      || m_dependency_graph->is_stale())
+  {
+    m_dependency_graph = std::make_unique<DependencyGraph>(object_tree.root());
+  }
+  const std::size_t n_updates = m_thread_pool == nullptr
+                                ? m_dependency_graph->evaluate()
+                                : m_dependency_graph->evaluate(*m_thread_pool);
+
+  // the root is updated whenever any other object is updated. If nothing but the root has been
+  // updated, only its transformation, which is not part of the list, may have changed.
+  if (n_updates > 1 || m_display_list_is_dirty) {
+    DisplayList display_list;
+    object_tree.root().append_display_lists(display_list, QTransform(), default_style());
+    if (m_display_list_is_dirty) {
+      // e.g., the order of objects might have changed.
+      m_damage.reset();
+    } else if (m_damage) {
+      const auto damage = DisplayList::damage(m_display_list, display_list);
+      m_damage->insert(m_damage->end(), damage.begin(), damage.end());
+      if (m_damage->size() > MAX_N_DAMAGED_REGIONS) {
+        m_damage.reset();
+      }
+    }
+    m_display_list = std::move(display_list);
+    m_display_list_is_dirty = false;
+  }
+}
+
+const DisplayList& Scene::display_list() const { return m_display_list; }
+
+std::optional<std::vector<QRectF>> Scene::take_damage()
+{
+  auto damage = std::move(m_damage);
+  m_damage = std::vector<QRectF>();
+  return damage;
+}
+
+void Scene::set_parallel_evaluation(const bool enabled)
+{
+  if (!enabled) {
+    m_thread_pool.reset();
+  } else if (m_thread_pool == nullptr) {
+    const std::size_t n_threads = std::max(1u, std::thread::hardware_concurrency());
+    m_thread_pool = std::make_unique<WorkStealingPool>(n_threads);
+  }
+}
+
+bool Scene::parallel_evaluation() const { return m_thread_pool != nullptr; }
+
+void Scene::on_image_loaded(const std::string& filename)
+{
+  for (Object* object : object_tree.items()) {
+    if (object->type() == ImageObject::TYPE
+        && object->property(ImageObject::FILEPATH_PROPERTY_KEY)->value<std::string>() == filename)
+    {
+      object->on_change(object, ImageObject::IMAGE_LOADED, nullptr, {});
+    }
+  }
 }
 
 bool Scene::contains(const AbstractPropertyOwner *apo) const
@@ -4,6 +4,7 @@
 #include <memory>
 #include <vector>
 #include <set>
+#include <optional>
 #include <cstdint>
 #include <QAbstractItemModel>
 #include <QUndoStack>
@@ -19,11 +20,16 @@
 #include "scene/history/historymodel.h"
 #include "tools/toolbox.h"
 #include "scene/abstractstructureobserver.h"
+#include "renderers/displaylist.h"
+#include "renderers/imagecache.h"
+#include "renderers/textlayoutcache.h"
 
 namespace omm
 {
 
 class Command;
+class DependencyGraph;
+class WorkStealingPool;
 class Project;
 class PythonEngine;
 
@@ -121,7 +127,6 @@ private:
 
 public:
   ToolBox tool_box;
-  void evaluate_tags();
 
 public:
   bool can_remove( QWidget* parent, std::set<AbstractPropertyOwner*> selection,
@@ -129,9 +134,60 @@ public:
   bool remove(QWidget* parent, const std::set<AbstractPropertyOwner*>& selection);
 
 public:
+  /**
+   * @brief evaluates the tags and updates the dirty objects and their dependents.
+   * @see DependencyGraph
+   */
   void update();
   bool contains(const AbstractPropertyOwner* apo) const;
 
+  /**
+   * @brief enables or disables the concurrent update of independent objects.
+   *  It is disabled by default, the Application enables it according to the settings.
+   */
+  void set_parallel_evaluation(const bool enabled);
+  bool parallel_evaluation() const;
+
+  /**
+   * @brief returns the draw commands of all visible objects in the coordinate system of the
+   *  root. The transformation of the root (i.e., the viewport) is applied by the Painter.
+   *  The list is rebuilt by `update`, reusing the display lists of unchanged objects.
+   */
+  const DisplayList& display_list() const;
+
+  /**
+   * @brief returns the regions (in the coordinate system of the root) which may look different
+   *  since the previous call. Returns nothing if the whole scene may look different.
+   */
+  std::optional<std::vector<QRectF>> take_damage();
+
+  /**
+   * @brief the decoded images, shared by all Painters of this scene.
+   */
+  ImageCache image_cache;
+
+  /**
+   * @brief marks the objects which draw the image `filename` dirty, hence they are recorded
+   *  again with the actual size of the image by the next `update`.
+   *  Must be called when `image_cache` has decoded an image in the background.
+   */
+  void on_image_loaded(const std::string& filename);
+
+  /**
+   * @brief the laid out texts, shared by all Painters of this scene.
+   */
+  TextLayoutCache text_layout_cache;
+
+private:
+  std::unique_ptr<DependencyGraph> m_dependency_graph;
+  std::unique_ptr<WorkStealingPool> m_thread_pool;
+  DisplayList m_display_list;
+  bool m_display_list_is_dirty = true;
+  std::optional<std::vector<QRectF>> m_damage;
+
+  // more damaged regions than that are considered as damage of the whole scene.
+  static constexpr std::size_t MAX_N_DAMAGED_REGIONS = 256;
+
 Q_SIGNALS:
   void object_selection_changed(const std::set<Object*>& selection);
   void style_selection_changed(const std::set<Style*>& selection);
@@ -0,0 +1,113 @@
+#include "scene/workstealingpool.h"
+#include <cassert>
+
+namespace
+{
+
+// identifies the pool and the deque of the current thread if it is a worker.
+thread_local const omm::WorkStealingPool* current_pool = nullptr;
+thread_local std::size_t current_queue = 0;
+
+}  // namespace
+
+namespace omm
+{
+
+WorkStealingPool::WorkStealingPool(const std::size_t n_threads)
+{
+  assert(n_threads > 0);
+  m_queues.reserve(n_threads);
+  for (std::size_t i = 0; i < n_threads; ++i) {
+    m_queues.push_back(std::make_unique<Queue>());
+  }
+  m_threads.reserve(n_threads);
+  for (std::size_t i = 0; i < n_threads; ++i) {
+    m_threads.emplace_back([this, i]() { run(i); });
+  }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+  wait();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_is_stopping = true;
+  }
+  m_work_available.notify_all();
+  for (std::thread& thread : m_threads) {
+    thread.join();
+  }
+}
+
+void WorkStealingPool::submit(Task task)
+{
+  m_n_pending += 1;
+  if (current_pool == this) {
+    Queue& queue = *m_queues[current_queue];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_front(std::move(task));
+  } else {
+    Queue& queue = *m_queues[m_next_queue++ % m_queues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  m_n_queued += 1;
+
+  // a worker checks for work while holding the mutex before it sleeps, hence it either sees the
+  // new task or it is already waiting and receives the notification.
+  { std::lock_guard<std::mutex> lock(m_mutex); }
+  m_work_available.notify_one();
+}
+
+void WorkStealingPool::wait()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_idle.wait(lock, [this]() { return m_n_pending == 0; });
+}
+
+std::size_t WorkStealingPool::n_threads() const { return m_threads.size(); }
+
+void WorkStealingPool::run(const std::size_t index)
+{
+  current_pool = this;
+  current_queue = index;
+  while (true) {
+    Task task;
+    if (pop(index, task)) {
+      task();
+      if (--m_n_pending == 0) {
+        { std::lock_guard<std::mutex> lock(m_mutex); }
+        m_idle.notify_all();
+      }
+    } else {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_work_available.wait(lock, [this]() { return m_is_stopping || m_n_queued > 0; });
+      if (m_is_stopping) {
+        return;
+      }
+    }
+  }
+}
+
+bool WorkStealingPool::pop(const std::size_t index, Task& task)
+{
+  const std::size_t n = m_queues.size();
+  for (std::size_t k = 0; k < n; ++k) {
+    Queue& queue = *m_queues[(index + k) % n];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      if (k == 0) {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      } else {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      }
+      m_n_queued -= 1;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace omm
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace omm
+{
+
+/**
+ * @brief The WorkStealingPool class runs tasks on a fixed set of worker threads.
+ *  Every worker has its own deque. A task submitted by a worker goes to the front of that
+ *  worker's deque, which is also where the worker takes its next task from. Idle workers steal
+ *  from the back of the other deques. Tasks submitted by other threads are distributed round
+ *  robin.
+ */
+class WorkStealingPool
+{
+public:
+  using Task = std::function<void()>;
+  explicit WorkStealingPool(const std::size_t n_threads);
+  ~WorkStealingPool();
+  WorkStealingPool(const WorkStealingPool&) = delete;
+  WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+  void submit(Task task);
+
+  /**
+   * @brief blocks until all tasks have finished, including the tasks submitted by tasks.
+   */
+  void wait();
+
+  std::size_t n_threads() const;
+
+private:
+  struct Queue
+  {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  std::vector<std::thread> m_threads;
+  std::atomic<std::size_t> m_n_queued = 0;   // submitted but not yet started
+  std::atomic<std::size_t> m_n_pending = 0;  // submitted but not yet finished
+  std::atomic<std::size_t> m_next_queue = 0;
+
+  std::mutex m_mutex;
+  std::condition_variable m_work_available;
+  std::condition_variable m_idle;
+  bool m_is_stopping = false;
+
+  void run(const std::size_t index);
+  bool pop(const std::size_t index, Task& task);
+};
+
+}  // namespace omm
@@ -65,12 +65,16 @@ void BrushSelectTool
   for (Object* object : scene.item_selection<Object>()) {
     Path* path = type_cast<Path*>(object);
     if (path) {
-      for (Point* point : path->points_ref()) {
-        // we can't transform `pos` with path's inverse transformation because if it scales,
-        // `radius` will be wrong.
-        const auto gpos = path->global_transformation().apply_to_position(point->position);
-        if ((gpos - pos).euclidean_norm() < radius) {
-          point->is_selected = extend_selection;
+      // we can't transform `pos` with path's inverse transformation because if it scales,
+      // `radius` will be wrong.
+      const auto points = path->points_ref();
+      const auto positions = ::transform<Vec2f>(points, [](const Point* point) {
+        return point->position;
+      });
+      const auto gpositions = path->global_transformation().apply_to_position(positions);
+      for (std::size_t i = 0; i < points.size(); ++i) {
+        if ((gpositions[i] - pos).euclidean_norm() < radius) {
+          points[i]->is_selected = extend_selection;
         }
       }
     }
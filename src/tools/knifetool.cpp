@@ -27,11 +27,8 @@ bool KnifeTool::mouse_move(const Vec2f &delta, const Vec2f &pos, const QMouseEve
   } else if (m_is_cutting) {
     m_points.clear();
     for (auto&& path : ::type_cast<Path*>(scene.item_selection<Object>())) {
-      auto ts = path->cut(m_mouse_press_pos, m_mouse_move_pos);
-      const auto g = path->global_transformation(false);
-      const auto ps = ::transform<Point>(ts, [&path, g](const double t) {
-        return g.apply(path->evaluate(t));
-      });
+      const auto ts = path->cut(m_mouse_press_pos, m_mouse_move_pos);
+      const auto ps = path->global_transformation(false).apply(path->evaluate(ts));
       m_points.insert(m_points.end(), ps.begin(), ps.end());
     }
   }
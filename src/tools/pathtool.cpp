@@ -19,6 +19,7 @@ bool PathTool::mouse_move(const Vec2f &delta, const Vec2f &pos, const QMouseEven
     const auto lt = PolarCoordinates(m_current_point->left_tangent.to_cartesian() + delta);
     m_current_point->left_tangent = lt;
     m_current_point->right_tangent = -lt;
+    m_path->on_points_changed({ m_path->point_index(m_current_point) }, { this });
     return true;
   } else {
     return false;
@@ -80,6 +81,7 @@ void PathTool::end()
     for (Point* point : m_path->points_ref()) {
       *point = t.apply(*point);
     }
+    m_path->on_change(m_path.get(), Path::POINTS_CHANGED, nullptr, { this });
     m_path->set_global_transformation(t.inverted(), false);
     m_path->property(Path::INTERPOLATION_PROPERTY_KEY)->set(Path::InterpolationMode::Bezier);
     scene.submit<add_command_type>(scene.object_tree, std::move(m_path));
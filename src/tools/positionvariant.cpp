@@ -43,11 +43,14 @@ Vec2f PointPositions::selection_center() const
 {
   std::set<Vec2f> positions;
   for (auto* path : paths()) {
+    std::vector<Vec2f> selected_positions;
     for (auto* point : path->points_ref()) {
       if (point->is_selected) {
-        positions.insert(path->global_transformation().apply_to_position(point->position));
+        selected_positions.push_back(point->position);
       }
     }
+    const auto gpositions = path->global_transformation().apply_to_position(selected_positions);
+    positions.insert(gpositions.begin(), gpositions.end());
   }
   return mean(positions, Vec2f::o());
 }
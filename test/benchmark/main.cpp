@@ -0,0 +1,42 @@
+#include <chrono>
+#include <iostream>
+#include "geometry/cubics.h"
+#include "common.h"
+#include "testgeometry.h"
+
+namespace
+{
+
+using clock = std::chrono::steady_clock;
+using ms = std::chrono::duration<double, std::milli>;
+
+void batch_evaluate()
+{
+  const omm::Cubics cubics(omm::RandomGeometry().points(1000), true);
+  static constexpr std::size_t n = 100000;
+  std::vector<double> ts(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    ts[i] = static_cast<double>(i) / static_cast<double>(n - 1);
+  }
+
+  const auto scalar_start = clock::now();
+  const auto scalar = ::transform<omm::Point>(ts, [&cubics](const double t) {
+    return cubics.evaluate(t);
+  });
+  const auto batch_start = clock::now();
+  const auto batch = cubics.evaluate(ts);
+  const auto batch_end = clock::now();
+
+  std::cout << "evaluate " << n << " parameters: scalar "
+            << ms(batch_start - scalar_start).count() << "ms, batch "
+            << ms(batch_end - batch_start).count() << "ms ("
+            << scalar.size() + batch.size() << " points)." << std::endl;
+}
+
+}  // namespace
+
+int main()
+{
+  batch_evaluate();
+  return 0;
+}
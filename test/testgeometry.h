@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include "geometry/point.h"
+
+namespace omm
+{
+
+/**
+ * @brief generates reproducible random geometry inside the square [-extent, extent]².
+ */
+class RandomGeometry
+{
+public:
+  explicit RandomGeometry(const unsigned seed = 42, const double extent = 100.0)
+    : m_rng(seed), m_distribution(-extent, extent)
+  {
+  }
+
+  double number() { return m_distribution(m_rng); }
+
+  Vec2f position()
+  {
+    const double x = number();
+    return Vec2f(x, number());
+  }
+
+  Point point()
+  {
+    const Vec2f position = this->position();
+    const PolarCoordinates left_tangent(this->position());
+    return Point(position, left_tangent, PolarCoordinates(this->position()));
+  }
+
+  std::vector<Point> points(const std::size_t n)
+  {
+    std::vector<Point> points;
+    points.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      points.push_back(point());
+    }
+    return points;
+  }
+
+private:
+  std::mt19937 m_rng;
+  std::uniform_real_distribution<double> m_distribution;
+};
+
+/**
+ * @brief returns the points of a closed path which approximates the circle around the origin
+ *  with four segments. The approximation deviates less than 0.03% of `radius` from the circle.
+ */
+inline std::vector<Point> circle(const double radius)
+{
+  const double k = 0.5522847498 * radius;
+  return {
+    Point(Vec2f(radius, 0.0), -M_PI/2.0, k),
+    Point(Vec2f(0.0, radius), 0.0, k),
+    Point(Vec2f(-radius, 0.0), M_PI/2.0, k),
+    Point(Vec2f(0.0, -radius), M_PI, k),
+  };
+}
+
+}  // namespace omm
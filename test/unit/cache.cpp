@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+#include <QDir>
+#include <QImage>
+#include <QTemporaryDir>
+#include "renderers/imagecache.h"
+#include "renderers/textlayoutcache.h"
+
+namespace
+{
+
+std::string make_image(const QTemporaryDir& directory, const QString& name)
+{
+  QImage image(64, 32, QImage::Format_ARGB32);
+  image.fill(Qt::red);
+  const QString filename = QDir(directory.path()).filePath(name);
+  EXPECT_TRUE(image.save(filename, "PNG"));
+  return filename.toStdString();
+}
+
+}  // namespace
+
+TEST(imagecache, levels)
+{
+  const QTemporaryDir directory;
+  ASSERT_TRUE(directory.isValid());
+  const std::string a = make_image(directory, "a.png");
+  omm::ImageCache cache;
+  EXPECT_EQ(cache.load(a).size(), QSize(64, 32));
+  EXPECT_EQ(cache.statistics().misses, 1u);
+
+  // the smallest level which is large enough.
+  EXPECT_EQ(cache.load(a, QSizeF(10.0, 5.0)).size(), QSize(16, 8));
+  EXPECT_EQ(cache.load(a, QSizeF(32.0, 16.0)).size(), QSize(32, 16));
+  EXPECT_EQ(cache.load(a, QSizeF(33.0, 1.0)).size(), QSize(64, 32));
+  EXPECT_EQ(cache.load(a, QSizeF(100.0, 100.0)).size(), QSize(64, 32));
+  EXPECT_EQ(cache.load(a, QSizeF()).size(), QSize(64, 32));
+  EXPECT_EQ(cache.statistics().hits, 5u);
+  EXPECT_EQ(cache.statistics().misses, 1u);
+
+  // images which cannot be loaded are cached, too.
+  EXPECT_TRUE(cache.load(QDir(directory.path()).filePath("missing.png").toStdString()).isNull());
+  EXPECT_EQ(cache.statistics().misses, 2u);
+}
+
+TEST(imagecache, eviction)
+{
+  const QTemporaryDir directory;
+  ASSERT_TRUE(directory.isValid());
+  const std::string a = make_image(directory, "a.png");
+  const std::string b = make_image(directory, "b.png");
+  const std::string c = make_image(directory, "c.png");
+  omm::ImageCache cache;
+  cache.load(a);
+  const std::size_t n_bytes = cache.size();
+  EXPECT_GT(n_bytes, std::size_t(64 * 32 * 4));
+
+  // the least recently used images are dropped.
+  cache.set_budget(2 * n_bytes);
+  cache.load(b);
+  cache.load(c);
+  EXPECT_EQ(cache.size(), 2 * n_bytes);
+  EXPECT_EQ(cache.statistics().evictions, 1u);
+  EXPECT_EQ(cache.statistics().misses, 3u);
+  cache.load(b);
+  EXPECT_EQ(cache.statistics().hits, 1u);
+  cache.load(a);
+  EXPECT_EQ(cache.statistics().misses, 4u);
+  EXPECT_EQ(cache.statistics().evictions, 2u);
+  cache.load(b);
+  EXPECT_EQ(cache.statistics().hits, 2u);
+
+  // the most recently used image is kept even if it exceeds the budget.
+  cache.set_budget(0);
+  EXPECT_EQ(cache.size(), n_bytes);
+  EXPECT_EQ(cache.statistics().evictions, 3u);
+  cache.load(b);
+  EXPECT_EQ(cache.statistics().hits, 3u);
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(imagecache, background_decoding)
+{
+  const QTemporaryDir directory;
+  ASSERT_TRUE(directory.isValid());
+  const std::string a = make_image(directory, "a.png");
+  omm::ImageCache cache;
+  std::vector<std::string> loaded;
+  cache.on_loaded = [&loaded](const std::string& filename) { loaded.push_back(filename); };
+
+  EXPECT_FALSE(cache.try_load(a, QSizeF(10.0, 5.0)).has_value());
+  EXPECT_EQ(cache.statistics().misses, 1u);
+  EXPECT_FALSE(cache.image_size(a).has_value());
+  cache.wait();
+  EXPECT_EQ(loaded, std::vector<std::string>{ a });
+  const auto image = cache.try_load(a, QSizeF(10.0, 5.0));
+  ASSERT_TRUE(image.has_value());
+  EXPECT_EQ(image->size(), QSize(16, 8));
+  EXPECT_EQ(cache.image_size(a), QSize(64, 32));
+  EXPECT_EQ(cache.statistics().hits, 1u);
+  EXPECT_EQ(cache.statistics().misses, 1u);
+}
+
+TEST(textlayoutcache, capacity)
+{
+  omm::TextLayoutCache cache(3);
+  const QFont font;
+  const QTextOption option;
+  const QStaticText text = cache.layout("a", font, option, 100.0);
+  EXPECT_EQ(text.text(), QString("a"));
+  EXPECT_EQ(text.textWidth(), 100.0);
+  cache.layout("a", font, option, 100.0);
+  EXPECT_EQ(cache.size(), 1u);
+
+  // the layout depends on the text, the font, the option and the width.
+  cache.layout("a", font, option, 50.0);
+  QFont bold_font = font;
+  bold_font.setBold(true);
+  cache.layout("a", bold_font, option, 100.0);
+  EXPECT_EQ(cache.size(), 3u);
+
+  // the least recently used layouts are dropped.
+  QTextOption centered_option = option;
+  centered_option.setAlignment(Qt::AlignCenter);
+  cache.layout("a", font, centered_option, 100.0);
+  cache.layout("b", font, option, 100.0);
+  EXPECT_EQ(cache.size(), 3u);
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0u);
+}
@@ -0,0 +1,144 @@
+#include "gtest/gtest.h"
+#include <cmath>
+#include "objects/cloner.h"
+#include "objects/ellipse.h"
+#include "objects/rectangleobject.h"
+#include "renderers/displaylist.h"
+#include "renderers/style.h"
+#include "tags/styletag.h"
+#include "testscene.h"
+
+namespace
+{
+
+void set_styles(omm::Object& object, const std::vector<omm::Style*>& styles)
+{
+  std::vector<std::unique_ptr<omm::Tag>> tags;
+  for (omm::Style* style : styles) {
+    auto tag = std::make_unique<omm::StyleTag>(object);
+    auto* reference = tag->property(omm::StyleTag::STYLE_REFERENCE_PROPERTY_KEY);
+    reference->set(static_cast<omm::AbstractPropertyOwner*>(style));
+    tags.push_back(std::move(tag));
+  }
+  object.tags.set(std::move(tags));
+}
+
+}  // namespace
+
+TEST(cloner, display_list_styles)
+{
+  omm::Style a(&omm::test_scene());
+  omm::Style b(&omm::test_scene());
+  b.property(omm::Style::PEN_WIDTH_KEY)->set(10.0);
+  omm::Cloner cloner(&omm::test_scene());
+  omm::Object& child = cloner.adopt(std::make_unique<omm::Ellipse>(&omm::test_scene()));
+  child.update();
+  cloner.update();
+
+  // the child has no style, hence it is recorded with the style of the cloner.
+  const auto list_a = child.display_list(a);
+  EXPECT_EQ(child.display_list(a), list_a);
+  const auto list_b = child.display_list(b);
+  EXPECT_NE(list_b, list_a);
+  EXPECT_NE(child.display_list(a), list_b);
+  EXPECT_NE(child.display_list(omm::test_scene().default_style()), child.display_list(a));
+
+  // restyling records the list again.
+  const auto list = child.display_list(a);
+  a.property(omm::Style::PEN_WIDTH_KEY)->set(3.0);
+  EXPECT_NE(child.display_list(a), list);
+
+  // the instances are drawn once per style.
+  set_styles(cloner, { &a, &b });
+  const std::size_t n_child_commands = child.display_list(a)->size();
+  EXPECT_GT(n_child_commands, 0u);
+  const auto& default_style = omm::test_scene().default_style();
+  EXPECT_EQ(cloner.display_list(default_style)->size(), 2 * 3 * n_child_commands);
+  set_styles(cloner, {});
+}
+
+TEST(cloner, instances)
+{
+  omm::Cloner cloner(&omm::test_scene());
+  EXPECT_EQ(cloner.convert()->n_children(), 0u);
+  cloner.adopt(std::make_unique<omm::Ellipse>(&omm::test_scene()));
+
+  const auto n_instances = [&cloner](const omm::Cloner::Mode mode) {
+    cloner.property(omm::Cloner::MODE_PROPERTY_KEY)->set(mode);
+    cloner.update();
+    return cloner.convert()->n_children();
+  };
+  EXPECT_EQ(n_instances(omm::Cloner::Mode::Linear), 3u);
+  EXPECT_EQ(n_instances(omm::Cloner::Mode::Grid), 9u);
+  EXPECT_EQ(n_instances(omm::Cloner::Mode::Radial), 3u);
+  EXPECT_EQ(n_instances(omm::Cloner::Mode::Path), 3u);
+  EXPECT_EQ(n_instances(omm::Cloner::Mode::FillRandom), 3u);
+  cloner.property(omm::Cloner::CODE_PROPERTY_KEY)->set(std::string("pass"));
+  EXPECT_EQ(n_instances(omm::Cloner::Mode::Script), 3u);
+
+  cloner.property(omm::Cloner::COUNT_2D_PROPERTY_KEY)->set(omm::Vec2i(4, 5));
+  EXPECT_EQ(n_instances(omm::Cloner::Mode::Grid), 20u);
+  cloner.property(omm::Cloner::IS_ACTIVE_PROPERTY_KEY)->set(false);
+  EXPECT_EQ(n_instances(omm::Cloner::Mode::Grid), 0u);
+}
+
+TEST(cloner, convert)
+{
+  omm::Cloner cloner(&omm::test_scene());
+  omm::Object& child = cloner.adopt(std::make_unique<omm::Ellipse>(&omm::test_scene()));
+  child.set_transformation(omm::ObjectTransformation({ 0.0, 0.0 }, { 2.0, 2.0 }, 0.0, 0.0));
+  cloner.property(omm::Cloner::MODE_PROPERTY_KEY)->set(omm::Cloner::Mode::Grid);
+  cloner.property(omm::Cloner::COUNT_2D_PROPERTY_KEY)->set(omm::Vec2i(2, 3));
+  cloner.property(omm::Cloner::DISTANCE_2D_PROPERTY_KEY)->set(omm::Vec2f(10.0, 20.0));
+  cloner.update();
+
+  // the instances keep the transformation of the child but are moved.
+  const auto converted = cloner.convert();
+  ASSERT_EQ(converted->n_children(), 6u);
+  for (std::size_t i = 0; i < 6; ++i) {
+    const omm::Object& instance = converted->tree_child(i);
+    EXPECT_EQ(instance.type(), omm::Ellipse::TYPE);
+    EXPECT_NEAR(instance.transformation().translation().x, 10.0 * (i % 2), 0.0001);
+    EXPECT_NEAR(instance.transformation().translation().y, 20.0 * (i / 2), 0.0001);
+    EXPECT_NEAR(instance.transformation().scaling().x, 2.0, 0.0001);
+  }
+}
+
+TEST(cloner, layout_and_structure)
+{
+  omm::Cloner cloner(&omm::test_scene());
+  cloner.adopt(std::make_unique<omm::Ellipse>(&omm::test_scene()));
+  cloner.adopt(std::make_unique<omm::RectangleObject>(&omm::test_scene()));
+  cloner.property(omm::Cloner::MODE_PROPERTY_KEY)->set(omm::Cloner::Mode::Radial);
+  cloner.update();
+
+  const auto expect_radial = [&cloner](const std::size_t count, const double radius) {
+    const auto converted = cloner.convert();
+    ASSERT_EQ(converted->n_children(), count);
+    for (std::size_t i = 0; i < count; ++i) {
+      const omm::Object& instance = converted->tree_child(i);
+      const double angle = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(count);
+      EXPECT_EQ(instance.type(), i % 2 == 0 ? omm::Ellipse::TYPE : omm::RectangleObject::TYPE);
+      EXPECT_NEAR(instance.transformation().translation().x, radius * std::cos(angle), 0.0001);
+      EXPECT_NEAR(instance.transformation().translation().y, radius * std::sin(angle), 0.0001);
+    }
+  };
+  expect_radial(3, 50.0);
+
+  // changing the radius only moves the instances.
+  cloner.property(omm::Cloner::RADIUS_PROPERTY_KEY)->set(80.0);
+  cloner.update();
+  expect_radial(3, 80.0);
+
+  // changing the count or the children rebuilds the structure.
+  cloner.property(omm::Cloner::COUNT_PROPERTY_KEY)->set(5);
+  cloner.update();
+  expect_radial(5, 80.0);
+  auto rectangle = cloner.repudiate(cloner.tree_child(1));
+  cloner.update();
+  const auto converted = cloner.convert();
+  ASSERT_EQ(converted->n_children(), 5u);
+  for (std::size_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(converted->tree_child(i).type(), omm::Ellipse::TYPE);
+  }
+}
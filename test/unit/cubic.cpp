@@ -1,5 +1,8 @@
 #include "gtest/gtest.h"
 #include "geometry/cubic.h"
+#include "geometry/cubics.h"
+#include "common.h"
+#include "testgeometry.h"
 
 TEST(cubic, find_roots)
 {
@@ -27,3 +30,237 @@ TEST(cubic, find_roots)
     }
   }
 }
+
+TEST(cubic, length)
+{
+  const omm::Cubic line({ omm::Vec2f(0.0, 0.0), omm::Vec2f(10.0, 0.0),
+                          omm::Vec2f(20.0, 0.0), omm::Vec2f(30.0, 0.0) });
+  EXPECT_LE(std::abs(line.length() - 30.0), 10e-10);
+
+  // length of the bezier-approximation of a quarter circle with radius 100.
+  static constexpr double k = 55.22847498;
+  const omm::Cubic arc({ omm::Vec2f(100.0, 0.0), omm::Vec2f(100.0, k),
+                         omm::Vec2f(k, 100.0), omm::Vec2f(0.0, 100.0) });
+  const double reference = arc.length(10e-8);
+  EXPECT_LE(std::abs(reference - 157.1017), 10e-4);
+  for (const double eps : { 1.0, 0.1, 0.01, 0.001 }) {
+    EXPECT_LE(std::abs(arc.length(eps) - reference), eps);
+  }
+}
+
+TEST(cubics, path_to_segment)
+{
+  std::vector<omm::Point> points;
+  for (std::size_t i = 0; i < 5; ++i) {
+    points.push_back(omm::Point(omm::Vec2f(10.0 * i, 0.0)));
+  }
+  const omm::Cubics cubics(points, false);
+  EXPECT_EQ(cubics.cumulative_length(0), 0.0);
+  EXPECT_EQ(cubics.cumulative_length(cubics.n_segments()), cubics.length());
+  EXPECT_LE(std::abs(cubics.length() - 40.0), 10e-10);
+
+  for (const double t : { 0.0, 0.1, 0.25, 0.3, 0.5, 0.75, 0.99, 1.0 }) {
+    const auto [segment_i, segment_t] = cubics.path_to_segment(t);
+    const std::size_t expected_segment_i = t == 0.0 ? 0 : static_cast<std::size_t>(std::ceil(4*t) - 1);
+    EXPECT_EQ(segment_i, expected_segment_i);
+    EXPECT_LE(std::abs(cubics.segment_to_path(segment_i, segment_t) - t), 10e-10);
+  }
+}
+
+TEST(cubics, batch_evaluate)
+{
+  const omm::Cubics cubics(omm::RandomGeometry().points(100), true);
+
+  static constexpr std::size_t n = 1000;
+  std::vector<double> ts(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    ts[i] = static_cast<double>(i) / static_cast<double>(n - 1);
+  }
+
+  const auto batch = cubics.evaluate(ts);
+  ASSERT_EQ(batch.size(), n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const omm::Point scalar = cubics.evaluate(ts[i]);
+    EXPECT_LE((scalar.position - batch[i].position).euclidean_norm(), 10e-8);
+    EXPECT_LE(std::abs(scalar.left_tangent.magnitude - batch[i].left_tangent.magnitude), 10e-8);
+  }
+}
+
+TEST(cubics, cut)
+{
+  omm::RandomGeometry random;
+  const omm::Cubics cubics(random.points(500), false);
+
+  for (std::size_t i = 0; i < 100; ++i) {
+    const omm::Vec2f a = random.position();
+    const omm::Vec2f b = random.position();
+
+    std::vector<double> expected_ts;
+    for (std::size_t segment_i = 0; segment_i < cubics.n_segments(); ++segment_i) {
+      for (const double segment_t : cubics.segment(segment_i).cut(a, b)) {
+        expected_ts.push_back(cubics.segment_to_path(segment_i, segment_t));
+      }
+    }
+
+    const auto ts = cubics.cut(a, b);
+    ASSERT_EQ(ts.size(), expected_ts.size());
+    for (std::size_t j = 0; j < ts.size(); ++j) {
+      EXPECT_EQ(ts[j], expected_ts[j]);
+    }
+  }
+}
+
+TEST(cubics, contains)
+{
+  // the precision does not depend on the size of the path.
+  for (const double r : { 100.0, 0.01 }) {
+    const omm::Cubics cubics(omm::circle(r), true);
+    omm::RandomGeometry random(42, 1.5 * r);
+    std::vector<omm::Vec2f> positions;
+    for (std::size_t i = 0; i < 10000; ++i) {
+      const omm::Vec2f p = random.position();
+      if (std::abs(p.euclidean_norm() - r) > 0.001 * r) {
+        positions.push_back(p);
+      }
+    }
+
+    const auto contains = cubics.contains(positions);
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+      const bool expected = positions[i].euclidean_norm() < r;
+      EXPECT_EQ(cubics.contains(positions[i]), expected);
+      EXPECT_EQ(contains[i], expected);
+    }
+  }
+
+  // an open path is implicitly closed.
+  const std::vector<omm::Point> triangle { omm::Point(omm::Vec2f(0.0, 0.0)),
+                                           omm::Point(omm::Vec2f(10.0, 0.0)),
+                                           omm::Point(omm::Vec2f(0.0, 10.0)) };
+  EXPECT_TRUE(omm::Cubics(triangle, false).contains(omm::Vec2f(2.0, 2.0)));
+  EXPECT_FALSE(omm::Cubics(triangle, false).contains(omm::Vec2f(8.0, 8.0)));
+}
+
+TEST(cubics, fill_rule)
+{
+  // two nested squares with the same orientation.
+  std::vector<omm::Point> points;
+  for (const double s : { 10.0, 5.0 }) {
+    points.push_back(omm::Point(omm::Vec2f(-s, -s)));
+    points.push_back(omm::Point(omm::Vec2f(s, -s)));
+    points.push_back(omm::Point(omm::Vec2f(s, s)));
+    points.push_back(omm::Point(omm::Vec2f(-s, s)));
+    points.push_back(omm::Point(omm::Vec2f(-s, -s)));
+  }
+  const omm::Cubics cubics(points, true);
+  using FillRule = omm::Cubics::FillRule;
+  EXPECT_FALSE(cubics.contains(omm::Vec2f(0.0, 0.0), FillRule::OddEven));
+  EXPECT_TRUE(cubics.contains(omm::Vec2f(0.0, 0.0), FillRule::NonZero));
+  EXPECT_TRUE(cubics.contains(omm::Vec2f(7.0, 0.0), FillRule::OddEven));
+  EXPECT_TRUE(cubics.contains(omm::Vec2f(7.0, 0.0), FillRule::NonZero));
+  EXPECT_FALSE(cubics.contains(omm::Vec2f(12.0, 0.0), FillRule::NonZero));
+}
+
+TEST(cubics, bounding_box)
+{
+  // the circle touches its bounding box at the segment ends, but the handles stick out.
+  static constexpr double r = 100.0;
+  const auto& box = omm::Cubics(omm::circle(r), true).bounding_box();
+  EXPECT_NEAR(box.left(), -r, 0.0001);
+  EXPECT_NEAR(box.right(), r, 0.0001);
+  EXPECT_NEAR(box.top(), -r, 0.0001);
+  EXPECT_NEAR(box.bottom(), r, 0.0001);
+
+  // the extrema of random segments are inside the box and the box is tight.
+  omm::RandomGeometry random;
+  std::vector<double> ts;
+  for (std::size_t i = 0; i <= 10000; ++i) {
+    ts.push_back(static_cast<double>(i) / 10000.0);
+  }
+  for (std::size_t i = 0; i < 100; ++i) {
+    const omm::Cubic cubic({ random.position(), random.position(),
+                             random.position(), random.position() });
+    const auto box = cubic.bounding_box();
+    omm::Vec2f lower = cubic.pos(0.0);
+    omm::Vec2f upper = cubic.pos(0.0);
+    for (const omm::Vec2f& p : cubic.pos(ts)) {
+      lower = omm::Vec2f::min(lower, p);
+      upper = omm::Vec2f::max(upper, p);
+    }
+    EXPECT_NEAR(box.left(), lower.x, 0.01);
+    EXPECT_NEAR(box.top(), lower.y, 0.01);
+    EXPECT_NEAR(box.right(), upper.x, 0.01);
+    EXPECT_NEAR(box.bottom(), upper.y, 0.01);
+  }
+}
+
+TEST(cubics, update)
+{
+  omm::RandomGeometry random;
+  for (const bool is_closed : { false, true }) {
+    std::vector<omm::Point> points = random.points(1000);
+    omm::Cubics cubics(points, is_closed);
+    cubics.length();  // the length table and the hierarchy must be updated, too.
+    cubics.bvh();
+
+    for (const std::set<std::size_t>& indices : std::vector<std::set<std::size_t>> {
+           { 0 }, { 999 }, { 1, 2, 500 }, { 0, 999 }, { 3, 17, 998 } }) {
+      for (const std::size_t i : indices) {
+        points[i] = random.point();
+      }
+      cubics.update(points, indices);
+      const omm::Cubics expected(points, is_closed);
+
+      ASSERT_EQ(cubics.n_segments(), expected.n_segments());
+      for (std::size_t i = 0; i < cubics.n_segments(); ++i) {
+        EXPECT_EQ(cubics.segment(i).pos(0.3), expected.segment(i).pos(0.3));
+        EXPECT_DOUBLE_EQ(cubics.lengths()[i], expected.lengths()[i]);
+        EXPECT_NEAR(cubics.cumulative_length(i + 1), expected.cumulative_length(i + 1),
+                    0.000001);
+      }
+      for (std::size_t i = 0; i < 10; ++i) {
+        const omm::Vec2f a = random.position();
+        const omm::Vec2f b = random.position();
+        EXPECT_EQ(cubics.bvh().intersect_line(a, b), expected.bvh().intersect_line(a, b));
+      }
+      EXPECT_EQ(cubics.bounding_box().top_left(), expected.bounding_box().top_left());
+      EXPECT_EQ(cubics.bounding_box().bottom_right(), expected.bounding_box().bottom_right());
+      const auto& path = cubics.painter_path();
+      ASSERT_EQ(path.elementCount(), expected.painter_path().elementCount());
+      for (int i = 0; i < path.elementCount(); ++i) {
+        EXPECT_EQ(path.elementAt(i), expected.painter_path().elementAt(i));
+      }
+    }
+  }
+}
+
+TEST(cubics, flattened)
+{
+  static constexpr double r = 100.0;
+  const omm::Cubics cubics(omm::circle(r), true);
+
+  std::size_t previous_n_vertices = 0;
+  for (const double tolerance : { 0.01, 0.1, 1.0, 10.0 }) {
+    const auto& vertices = cubics.flattened(tolerance);
+    ASSERT_GE(vertices.size(), 3u);
+    EXPECT_EQ(vertices.front(), vertices.back());
+    for (std::size_t i = 0; i < vertices.size(); ++i) {
+      // the bezier circle itself deviates up to 0.03 from the true circle.
+      EXPECT_NEAR(vertices[i].euclidean_norm(), r, tolerance + 0.03);
+      if (i > 0) {
+        const omm::Vec2f mid = (vertices[i] + vertices[i-1]) / 2.0;
+        EXPECT_NEAR(mid.euclidean_norm(), r, tolerance + 0.03);
+      }
+    }
+    if (previous_n_vertices > 0) {
+      EXPECT_LT(vertices.size(), previous_n_vertices);
+    }
+    previous_n_vertices = vertices.size();
+  }
+
+  // the number of vertices is proportional to the length, not to the number of segments.
+  std::vector<omm::Point> dense;
+  for (std::size_t i = 0; i < 10000; ++i) {
+    dense.push_back(omm::Point(omm::Vec2f(static_cast<double>(i) / 100.0, 0.0)));
+  }
+  EXPECT_LE(omm::Cubics(dense, false).flattened(1.0).size(), 201u);
+}
@@ -0,0 +1,350 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <tuple>
+#include <QDir>
+#include <QImage>
+#include <QPainter>
+#include <QPixmap>
+#include <QTemporaryDir>
+#include "geometry/cubics.h"
+#include "objects/cloner.h"
+#include "objects/ellipse.h"
+#include "objects/imageobject.h"
+#include "renderers/displaylist.h"
+#include "renderers/painter.h"
+#include "renderers/rastercache.h"
+#include "testscene.h"
+
+namespace
+{
+
+const omm::DisplayList::Paint paint { QPen(Qt::NoPen), QBrush(Qt::black) };
+
+std::shared_ptr<const omm::Cubics> rectangle(const QRectF& rect)
+{
+  const std::vector<omm::Point> points {
+    omm::Point(omm::Vec2f(rect.left(), rect.top())),
+    omm::Point(omm::Vec2f(rect.right(), rect.top())),
+    omm::Point(omm::Vec2f(rect.right(), rect.bottom())),
+    omm::Point(omm::Vec2f(rect.left(), rect.bottom())),
+  };
+  return std::make_shared<const omm::Cubics>(points, true);
+}
+
+void add_group(omm::DisplayList& list, const void* key, const QRectF& rect,
+               const std::size_t revision)
+{
+  const std::size_t group = list.begin_group(key);
+  list.add_path(QTransform(), paint, rectangle(rect));
+  list.end_group(group, revision, revision);
+}
+
+void expect_rects(std::vector<QRectF> actual, std::vector<QRectF> expected)
+{
+  const auto less = [](const QRectF& a, const QRectF& b) {
+    return std::tuple(a.left(), a.top(), a.width(), a.height())
+         < std::tuple(b.left(), b.top(), b.width(), b.height());
+  };
+  std::sort(actual.begin(), actual.end(), less);
+  std::sort(expected.begin(), expected.end(), less);
+  ASSERT_EQ(actual.size(), expected.size());
+  for (std::size_t i = 0; i < actual.size(); ++i) {
+    EXPECT_NEAR(actual[i].left(), expected[i].left(), 0.0001);
+    EXPECT_NEAR(actual[i].top(), expected[i].top(), 0.0001);
+    EXPECT_NEAR(actual[i].right(), expected[i].right(), 0.0001);
+    EXPECT_NEAR(actual[i].bottom(), expected[i].bottom(), 0.0001);
+  }
+}
+
+}  // namespace
+
+TEST(displaylist, group_bounds)
+{
+  const int a = 0;
+  const int b = 0;
+  omm::DisplayList list;
+  const std::size_t group_a = list.begin_group(&a);
+  list.add_path(QTransform(), paint, rectangle({ 0.0, 0.0, 10.0, 10.0 }));
+  const std::size_t group_b = list.begin_group(&b);
+  list.add_path(QTransform::fromTranslate(100.0, 0.0), paint, rectangle({ 0.0, 0.0, 10.0, 10.0 }));
+  list.end_group(group_b, 1, 1);
+  list.add_path(QTransform(), paint, rectangle({ 20.0, 0.0, 10.0, 10.0 }));
+  list.end_group(group_a, 1, 1);
+  EXPECT_EQ(list.size(), 3u);
+
+  // a new group is damaged by its own commands only, the nested groups are damaged on their own.
+  expect_rects(omm::DisplayList::damage(omm::DisplayList(), list),
+               { { 0.0, 0.0, 30.0, 10.0 }, { 100.0, 0.0, 10.0, 10.0 } });
+
+  // appending maps the commands and the groups.
+  omm::DisplayList appended;
+  appended.append(list, QTransform::fromScale(2.0, 1.0) * QTransform::fromTranslate(0.0, 50.0));
+  EXPECT_EQ(appended.size(), 3u);
+  expect_rects(omm::DisplayList::damage(omm::DisplayList(), appended),
+               { { 0.0, 50.0, 60.0, 10.0 }, { 200.0, 50.0, 20.0, 10.0 } });
+
+  // appending the commands drops the groups.
+  omm::DisplayList commands;
+  const std::size_t group = commands.begin_group(&a);
+  commands.append_commands(list, QTransform());
+  commands.append_commands(list, QTransform::fromTranslate(0.0, 20.0));
+  commands.end_group(group);
+  EXPECT_EQ(commands.size(), 6u);
+  expect_rects(omm::DisplayList::damage(omm::DisplayList(), commands),
+               { { 0.0, 0.0, 110.0, 30.0 } });
+
+  // the bounds include the pen.
+  omm::DisplayList stroked;
+  QPen pen(Qt::black, 2.0);
+  pen.setMiterLimit(1.0);
+  const std::size_t stroked_group = stroked.begin_group(&a);
+  stroked.add_path(QTransform(), { pen, QBrush() }, rectangle({ 0.0, 0.0, 10.0, 10.0 }));
+  stroked.end_group(stroked_group);
+  expect_rects(omm::DisplayList::damage(omm::DisplayList(), stroked),
+               { { -1.0, -1.0, 12.0, 12.0 } });
+}
+
+TEST(displaylist, culling)
+{
+  const int a = 0;
+  const int b = 0;
+  const int c = 0;
+  const int d = 0;
+  omm::DisplayList list;
+  add_group(list, &a, { 0.0, 0.0, 10.0, 10.0 }, 1);
+  add_group(list, &b, { 500.0, 500.0, 10.0, 10.0 }, 1);
+  const std::size_t group_c = list.begin_group(&c);
+  list.add_path(QTransform(), paint, rectangle({ 1000.0, 0.0, 10.0, 10.0 }));
+  add_group(list, &d, { 1000.0, 20.0, 10.0, 10.0 }, 1);
+  list.end_group(group_c);
+
+  QImage image(100, 100, QImage::Format_ARGB32_Premultiplied);
+  QPainter painter(&image);
+  omm::Painter renderer(omm::test_scene(), omm::Painter::Category::Objects);
+  renderer.painter = &painter;
+
+  // nothing is culled if there is no viewport.
+  EXPECT_EQ(list.replay(renderer), 0u);
+
+  // nested groups are culled with their parent.
+  renderer.viewport_rect = QRectF(0.0, 0.0, 100.0, 100.0);
+  EXPECT_EQ(list.replay(renderer), 3u);
+  painter.setTransform(QTransform::fromTranslate(-495.0, -495.0));
+  EXPECT_EQ(list.replay(renderer), 3u);
+  painter.setTransform(QTransform::fromScale(0.05, 0.05));
+  EXPECT_EQ(list.replay(renderer), 0u);
+
+  // groups which almost touch the viewport are drawn.
+  painter.setTransform(QTransform::fromTranslate(-511.0, -511.0));
+  EXPECT_EQ(list.replay(renderer), 3u);
+  painter.setTransform(QTransform::fromTranslate(-515.0, -515.0));
+  EXPECT_EQ(list.replay(renderer), 4u);
+}
+
+TEST(displaylist, raster_cache)
+{
+  const int a = 0;
+  const int b = 0;
+  const int c = 0;
+  const QPixmap pixmap(10, 10);
+  const QTransform zoom = QTransform::fromScale(2.0, 2.0);
+  omm::RasterCache cache(0);
+  bool should_rasterize = true;
+
+  // a subtree is rasterized if it has been requested twice in the same state in a row.
+  EXPECT_EQ(cache.find(&a, 1, QTransform(), should_rasterize), nullptr);
+  EXPECT_FALSE(should_rasterize);
+  EXPECT_EQ(cache.find(&a, 1, QTransform(), should_rasterize), nullptr);
+  EXPECT_TRUE(should_rasterize);
+  EXPECT_EQ(cache.find(&a, 2, QTransform(), should_rasterize), nullptr);
+  EXPECT_FALSE(should_rasterize);
+  EXPECT_EQ(cache.find(&a, 2, QTransform::fromTranslate(3.0, -1.0), should_rasterize), nullptr);
+  EXPECT_TRUE(should_rasterize);
+  EXPECT_EQ(cache.find(&a, 2, zoom, should_rasterize), nullptr);
+  EXPECT_FALSE(should_rasterize);
+
+  // the pixmap can be moved by whole pixels.
+  cache.insert(&a, 2, zoom, pixmap);
+  EXPECT_NE(cache.find(&a, 2, zoom * QTransform::fromTranslate(5.0, 7.0), should_rasterize),
+            nullptr);
+  EXPECT_FALSE(should_rasterize);
+  EXPECT_EQ(cache.find(&a, 2, zoom * QTransform::fromTranslate(0.5, 0.0), should_rasterize),
+            nullptr);
+  EXPECT_EQ(cache.find(&a, 3, zoom, should_rasterize), nullptr);
+
+  // the least recently used pixmaps are dropped.
+  const std::size_t n_bytes = cache.size();
+  EXPECT_GT(n_bytes, 0u);
+  cache.set_budget(2 * n_bytes);
+  cache.insert(&b, 1, QTransform(), pixmap);
+  cache.insert(&c, 1, QTransform(), pixmap);
+  EXPECT_EQ(cache.size(), 2 * n_bytes);
+  EXPECT_NE(cache.find(&b, 1, QTransform(), should_rasterize), nullptr);
+  cache.insert(&a, 1, QTransform(), pixmap);
+  EXPECT_EQ(cache.size(), 2 * n_bytes);
+  EXPECT_EQ(cache.find(&c, 1, QTransform(), should_rasterize), nullptr);
+  EXPECT_NE(cache.find(&b, 1, QTransform(), should_rasterize), nullptr);
+  EXPECT_NE(cache.find(&a, 1, QTransform(), should_rasterize), nullptr);
+
+  // the most recently used pixmap is kept even if it exceeds the budget.
+  cache.set_budget(1);
+  EXPECT_EQ(cache.size(), n_bytes);
+  EXPECT_NE(cache.find(&a, 1, QTransform(), should_rasterize), nullptr);
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(displaylist, damage)
+{
+  const int unchanged = 0;
+  const int changed = 0;
+  const int moved = 0;
+  const int removed = 0;
+  const int added = 0;
+
+  omm::DisplayList before;
+  add_group(before, &unchanged, { 0.0, 0.0, 10.0, 10.0 }, 1);
+  add_group(before, &changed, { 20.0, 0.0, 10.0, 10.0 }, 1);
+  add_group(before, &moved, { 40.0, 0.0, 10.0, 10.0 }, 1);
+  add_group(before, &removed, { 60.0, 0.0, 10.0, 10.0 }, 1);
+
+  omm::DisplayList after;
+  add_group(after, &added, { 80.0, 0.0, 10.0, 10.0 }, 1);
+  add_group(after, &moved, { 40.0, 30.0, 10.0, 10.0 }, 1);
+  add_group(after, &changed, { 20.0, 0.0, 10.0, 10.0 }, 2);
+  add_group(after, &unchanged, { 0.0, 0.0, 10.0, 10.0 }, 1);
+
+  // the order of the groups does not matter.
+  expect_rects(omm::DisplayList::damage(before, after), {
+    { 20.0, 0.0, 10.0, 10.0 }, { 20.0, 0.0, 10.0, 10.0 },
+    { 40.0, 0.0, 10.0, 10.0 }, { 40.0, 30.0, 10.0, 10.0 },
+    { 60.0, 0.0, 10.0, 10.0 },
+    { 80.0, 0.0, 10.0, 10.0 },
+  });
+  EXPECT_TRUE(omm::DisplayList::damage(after, after).empty());
+}
+
+TEST(displaylist, scene_damage)
+{
+  omm::Scene& scene = omm::test_scene();
+  omm::Object& root = scene.object_tree.root();
+  omm::Object& a = root.adopt(std::make_unique<omm::Ellipse>(&scene));
+  omm::Object& b = root.adopt(std::make_unique<omm::Ellipse>(&scene));
+  b.set_transformation(omm::ObjectTransformation({ 200.0, 0.0 }, { 1.0, 1.0 }, 0.0, 0.0));
+
+  // the hierarchy has changed, hence everything may look different.
+  scene.invalidate();
+  scene.update();
+  EXPECT_FALSE(scene.take_damage().has_value());
+  scene.update();
+  ASSERT_TRUE(scene.take_damage().has_value());
+
+  // the old and the new region of the moved object are damaged.
+  const auto bounds = [&scene]() {
+    return omm::DisplayList::damage(omm::DisplayList(), scene.display_list());
+  };
+  const auto bounds_before = bounds();
+  a.set_transformation(omm::ObjectTransformation({ 0.0, 100.0 }, { 1.0, 1.0 }, 0.0, 0.0));
+  scene.update();
+  const auto damage = scene.take_damage();
+  ASSERT_TRUE(damage.has_value());
+  ASSERT_FALSE(bounds_before.empty());
+  const QRectF old_bounds = bounds_before.front();
+  expect_rects(*damage, { old_bounds, old_bounds.translated(0.0, 100.0) });
+  ASSERT_TRUE(scene.take_damage().has_value());
+  EXPECT_TRUE(scene.take_damage()->empty());
+
+  // too many damaged regions are considered as damage of the whole scene.
+  std::vector<omm::Object*> objects;
+  for (std::size_t i = 0; i < 200; ++i) {
+    objects.push_back(&root.adopt(std::make_unique<omm::Ellipse>(&scene)));
+  }
+  scene.invalidate();
+  scene.update();
+  scene.take_damage();
+  for (std::size_t i = 0; i < objects.size(); ++i) {
+    const double x = 10.0 * static_cast<double>(i);
+    objects[i]->set_transformation(omm::ObjectTransformation({ x, 0.0 }, { 1.0, 1.0 }, 0.0, 0.0));
+  }
+  scene.update();
+  EXPECT_FALSE(scene.take_damage().has_value());
+
+  while (root.n_children() > 0) {
+    root.repudiate(root.tree_child(0));
+  }
+  scene.invalidate();
+  scene.update();
+}
+
+TEST(displaylist, image_bounds)
+{
+  const QTemporaryDir directory;
+  ASSERT_TRUE(directory.isValid());
+  const QString filename = QDir(directory.path()).filePath("image.png");
+  QImage image(64, 32, QImage::Format_ARGB32);
+  image.fill(Qt::red);
+  ASSERT_TRUE(image.save(filename, "PNG"));
+
+  omm::Scene& scene = omm::test_scene();
+  omm::Object& root = scene.object_tree.root();
+  omm::Object& object = root.adopt(std::make_unique<omm::ImageObject>(&scene));
+  object.property(omm::ImageObject::FILEPATH_PROPERTY_KEY)->set(filename.toStdString());
+  object.property(omm::ImageObject::WIDTH_PROPERTY_KEY)->set(100.0);
+  const auto bounds = [&scene]() {
+    return omm::DisplayList::damage(omm::DisplayList(), scene.display_list());
+  };
+
+  // the height is unknown before the image is decoded, hence the image may cover anything.
+  scene.invalidate();
+  scene.update();
+  ASSERT_EQ(bounds().size(), 1u);
+  EXPECT_GT(bounds().front().width(), 1.0e6);
+
+  // the object is recorded again once the image has been decoded.
+  scene.image_cache.load(filename.toStdString());
+  scene.on_image_loaded(filename.toStdString());
+  EXPECT_TRUE(object.is_dirty());
+  scene.update();
+  expect_rects(bounds(), { { 0.0, 0.0, 100.0, 50.0 } });
+
+  root.repudiate(object);
+  scene.invalidate();
+  scene.update();
+}
+
+TEST(displaylist, ancestor_lists)
+{
+  omm::Scene& scene = omm::test_scene();
+  const omm::Style& style = scene.default_style();
+  omm::Object& root = scene.object_tree.root();
+  omm::Object& parent = root.adopt(std::make_unique<omm::Ellipse>(&scene));
+  omm::Object& child = parent.adopt(std::make_unique<omm::Ellipse>(&scene));
+  omm::Object& cloner = root.adopt(std::make_unique<omm::Cloner>(&scene));
+  omm::Object& clone = cloner.adopt(std::make_unique<omm::Ellipse>(&scene));
+  scene.invalidate();
+  scene.update();
+  const auto parent_list = parent.display_list(style);
+  const auto child_list = child.display_list(style);
+  const auto cloner_list = cloner.display_list(style);
+
+  // the parent draws the same as before, only the child is recorded again.
+  child.property(omm::Ellipse::RADIUS_PROPERTY_KEY)->set(omm::Vec2f(10.0, 10.0));
+  scene.update();
+  EXPECT_EQ(parent.display_list(style), parent_list);
+  EXPECT_NE(child.display_list(style), child_list);
+  EXPECT_EQ(cloner.display_list(style), cloner_list);
+  parent.property(omm::Ellipse::RADIUS_PROPERTY_KEY)->set(omm::Vec2f(10.0, 10.0));
+  scene.update();
+  EXPECT_NE(parent.display_list(style), parent_list);
+
+  // the cloner draws its children itself.
+  clone.property(omm::Ellipse::RADIUS_PROPERTY_KEY)->set(omm::Vec2f(10.0, 10.0));
+  scene.update();
+  EXPECT_NE(cloner.display_list(style), cloner_list);
+
+  while (root.n_children() > 0) {
+    root.repudiate(root.tree_child(0));
+  }
+  scene.invalidate();
+  scene.update();
+}
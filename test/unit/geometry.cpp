@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 #include <random>
 #include "geometry/objecttransformation.h"
+#include "geometry/polygon.h"
 #include "logging.h"
 
 namespace
@@ -176,3 +177,86 @@ TEST(geometry, transform_to_from_mat_random)
     EXPECT_TRUE(fuzzy_equal(t, omm::ObjectTransformation(t.to_mat())));
   }
 }
+
+TEST(geometry, transform_affine)
+{
+  std::mt19937 rng;
+  rng.seed(42);
+  std::uniform_real_distribution<> distribution(-100, 100);
+  constexpr auto n = 1000;
+
+  std::vector<omm::Vec2f> positions;
+  std::vector<omm::Point> points;
+  for (size_t i = 0; i < n; ++i) {
+    positions.push_back({ distribution(rng), distribution(rng) });
+    points.push_back(omm::Point(positions.back(), distribution(rng), distribution(rng)));
+  }
+
+  for (size_t i = 0; i < 100; ++i) {
+    const omm::Vec2f translation(distribution(rng), distribution(rng));
+    const omm::Vec2f scaling(distribution(rng), distribution(rng));
+    const double rotation = distribution(rng);
+    const double shearing = distribution(rng);
+    const omm::ObjectTransformation t(translation, scaling, rotation, shearing);
+
+    const omm::Matrix reference
+        = omm::Matrix({ { 1, 0, translation.x }, { 0, 1, translation.y }, { 0, 0, 1 } })
+        * omm::Matrix({ { std::cos(rotation), -std::sin(rotation), 0 },
+                        { std::sin(rotation),  std::cos(rotation), 0 },
+                        { 0, 0, 1 } })
+        * omm::Matrix({ { scaling.x, 0, 0 }, { 0, scaling.y, 0 }, { 0, 0, 1 } })
+        * omm::Matrix({ { 1, 0, 0 }, { shearing, 1, 0 }, { 0, 0, 1 } });
+    for (std::size_t r = 0; r < 3; ++r) {
+      for (std::size_t c = 0; c < 3; ++c) {
+        const double eps = 0.0001 * (1.0 + std::abs(reference.m[r][c]));
+        EXPECT_NEAR(t.to_mat().m[r][c], reference.m[r][c], eps);
+      }
+    }
+
+    const auto gpositions = t.apply_to_position(positions);
+    const auto gdirections = t.apply_to_direction(positions);
+    const auto gpoints = t.apply(points);
+    for (size_t j = 0; j < n; ++j) {
+      EXPECT_EQ(gpositions[j], t.apply_to_position(positions[j]));
+      EXPECT_EQ(gdirections[j], t.apply_to_direction(positions[j]));
+      const omm::Point p = t.apply(points[j]);
+      EXPECT_EQ(gpoints[j].position, p.position);
+      EXPECT_EQ(gpoints[j].left_tangent.to_cartesian(), p.left_tangent.to_cartesian());
+      EXPECT_EQ(gpoints[j].right_tangent.to_cartesian(), p.right_tangent.to_cartesian());
+    }
+
+    const auto inverse_positions = t.inverted().apply_to_position(gpositions);
+    for (size_t j = 0; j < n; ++j) {
+      EXPECT_NEAR(inverse_positions[j].x, positions[j].x, 0.001);
+      EXPECT_NEAR(inverse_positions[j].y, positions[j].y, 0.001);
+    }
+  }
+}
+
+TEST(geometry, polygon_comb)
+{
+  // many tall edges overlap each other vertically.
+  static constexpr std::size_t n_teeth = 2000;
+  std::vector<omm::Vec2f> vertices;
+  for (std::size_t i = 0; i < n_teeth; ++i) {
+    const double x = 2.0 * static_cast<double>(i);
+    vertices.push_back(omm::Vec2f(x, 0.0));
+    vertices.push_back(omm::Vec2f(x, 100.0));
+    vertices.push_back(omm::Vec2f(x + 1.0, 100.0));
+    vertices.push_back(omm::Vec2f(x + 1.0, 0.0));
+  }
+  vertices.push_back(omm::Vec2f(2.0 * n_teeth, 0.0));
+  vertices.push_back(omm::Vec2f(2.0 * n_teeth, -10.0));
+  vertices.push_back(omm::Vec2f(0.0, -10.0));
+  const omm::Polygon polygon(vertices);
+
+  for (std::size_t i = 0; i < n_teeth; i += 7) {
+    const double x = 2.0 * static_cast<double>(i);
+    for (const double y : { 0.5, 50.0, 99.5 }) {
+      EXPECT_TRUE(polygon.contains(omm::Vec2f(x + 0.5, y)));
+      EXPECT_FALSE(polygon.contains(omm::Vec2f(x + 1.5, y)));
+    }
+    EXPECT_TRUE(polygon.contains(omm::Vec2f(x + 1.5, -5.0)));
+    EXPECT_FALSE(polygon.contains(omm::Vec2f(x + 0.5, 100.5)));
+  }
+}
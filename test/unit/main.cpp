@@ -4,6 +4,9 @@
 
 int main(int argc, char* argv[])
 {
+  // pixmaps and fonts require an application, but no display.
+  qputenv("QT_QPA_PLATFORM", "offscreen");
+  QApplication app(argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
@@ -0,0 +1,246 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <thread>
+#include "objects/cloner.h"
+#include "objects/ellipse.h"
+#include "objects/instance.h"
+#include "objects/mirror.h"
+#include "objects/outline.h"
+#include "objects/path.h"
+#include "scene/dependencygraph.h"
+#include "scene/workstealingpool.h"
+#include "testgeometry.h"
+#include "testscene.h"
+
+namespace
+{
+
+void expect_near(const omm::ObjectTransformation& a, const omm::ObjectTransformation& b)
+{
+  for (std::size_t r = 0; r < 3; ++r) {
+    for (std::size_t c = 0; c < 3; ++c) {
+      EXPECT_NEAR(a.to_mat().m[r][c], b.to_mat().m[r][c], 0.0001);
+    }
+  }
+}
+
+/**
+ * @brief remembers the thread which has updated the object last.
+ */
+template<typename T> class Recording : public T
+{
+public:
+  using T::T;
+  void update() override
+  {
+    thread = std::this_thread::get_id();
+    T::update();
+  }
+
+  std::thread::id thread;
+};
+
+struct Group
+{
+  omm::Object* outline;
+  omm::Object* mirror;
+  Recording<omm::Instance>* instance;
+  Recording<omm::Cloner>* cloner;
+};
+
+/**
+ * @brief adds a path and objects which depend on it in different ways to `parent`.
+ */
+Group add_group(omm::Object& parent, omm::RandomGeometry& random)
+{
+  omm::Scene* scene = &omm::test_scene();
+  auto& path = static_cast<omm::Path&>(parent.adopt(std::make_unique<omm::Path>(scene)));
+  path.set_points(random.points(10));
+  auto* const reference = static_cast<omm::AbstractPropertyOwner*>(&path);
+
+  Group group;
+  group.outline = &parent.adopt(std::make_unique<omm::Outline>(scene));
+  group.outline->property(omm::Outline::REFERENCE_PROPERTY_KEY)->set(reference);
+  group.outline->property(omm::Outline::OFFSET_PROPERTY_KEY)->set(5.0);
+
+  group.mirror = &parent.adopt(std::make_unique<omm::Mirror>(scene));
+  group.mirror->property(omm::Mirror::AS_PATH_PROPERTY_KEY)->set(omm::Mirror::Mode::Path);
+  auto& mirrored = group.mirror->adopt(std::make_unique<omm::Path>(scene));
+  static_cast<omm::Path&>(mirrored).set_points(random.points(10));
+
+  auto instance = std::make_unique<Recording<omm::Instance>>(scene);
+  group.instance = instance.get();
+  parent.adopt(std::move(instance));
+  group.instance->property(omm::Instance::REFERENCE_PROPERTY_KEY)->set(reference);
+
+  auto cloner = std::make_unique<Recording<omm::Cloner>>(scene);
+  group.cloner = cloner.get();
+  parent.adopt(std::move(cloner));
+  group.cloner->property(omm::Cloner::MODE_PROPERTY_KEY)->set(omm::Cloner::Mode::Script);
+  group.cloner->property(omm::Cloner::CODE_PROPERTY_KEY)->set(std::string("pass"));
+  group.cloner->adopt(std::make_unique<omm::Ellipse>(scene));
+  return group;
+}
+
+/**
+ * @brief provides a root without scene, the tests build the hierarchy below it.
+ */
+class ObjectTree : public ::testing::Test
+{
+protected:
+  omm::Scene* const scene = nullptr;
+  omm::Path root { scene };
+
+  template<typename T = omm::Path> omm::Object& add(omm::Object& parent)
+  {
+    return parent.adopt(std::make_unique<T>(scene));
+  }
+};
+
+}  // namespace
+
+TEST_F(ObjectTree, global_transformation_cache)
+{
+  omm::Object& a = add(root);
+  omm::Object& b = add(a);
+  omm::Object& c = add(root);
+  const omm::ObjectTransformation ta({ 1.0, 2.0 }, { 2.0, 2.0 }, 0.5, 0.0);
+  const omm::ObjectTransformation tb({ -3.0, 1.0 }, { 1.0, 0.5 }, -1.0, 0.2);
+  const omm::ObjectTransformation tc({ 4.0, 0.0 }, { 1.0, 1.0 }, 2.0, 0.0);
+  a.set_transformation(ta);
+  b.set_transformation(tb);
+  c.set_transformation(tc);
+
+  expect_near(b.global_transformation(), root.transformation().apply(ta).apply(tb));
+  expect_near(b.global_transformation(true), ta.apply(tb));
+
+  // nothing changed, hence all three levels are answered from the cache.
+  omm::Object::reset_global_transformation_cache_statistics();
+  b.global_transformation();
+  EXPECT_EQ(omm::Object::global_transformation_cache_statistics().hits, std::size_t(3));
+  EXPECT_EQ(omm::Object::global_transformation_cache_statistics().misses, std::size_t(0));
+
+  // changing an ancestor invalidates the descendants.
+  const omm::ObjectTransformation ta2({ 0.0, -2.0 }, { 1.0, 3.0 }, 1.5, 0.1);
+  a.set_transformation(ta2);
+  expect_near(b.global_transformation(), ta2.apply(tb));
+
+  // reparenting keeps the global transformation but later changes of the new parent propagate.
+  const auto global_b = b.global_transformation();
+  b.reset_parent(c);
+  expect_near(b.global_transformation(), global_b);
+  const omm::ObjectTransformation tc2({ 1.0, 1.0 }, { 0.5, 0.5 }, 0.0, 0.0);
+  c.set_transformation(tc2);
+  expect_near(b.global_transformation(), tc2.apply(b.transformation()));
+}
+
+TEST_F(ObjectTree, dirty_tracking)
+{
+  omm::Object& a = add(root);
+  omm::Object& b = add(a);
+  omm::Object& c = add(root);
+  const omm::DependencyGraph graph(root);
+  EXPECT_EQ(graph.evaluate(), 4u);
+  EXPECT_FALSE(root.is_dirty());
+  EXPECT_FALSE(b.is_dirty());
+  EXPECT_EQ(graph.evaluate(), 0u);
+
+  // a change marks the object and its ancestors dirty, but not its siblings.
+  b.set_transformation(omm::ObjectTransformation({ 1.0, 2.0 }, { 1.0, 1.0 }, 0.0, 0.0));
+  EXPECT_TRUE(b.is_dirty());
+  EXPECT_TRUE(a.is_dirty());
+  EXPECT_TRUE(root.is_dirty());
+  EXPECT_FALSE(c.is_dirty());
+
+  EXPECT_EQ(graph.evaluate(), 3u);
+  EXPECT_FALSE(root.is_dirty());
+  EXPECT_FALSE(a.is_dirty());
+  EXPECT_FALSE(b.is_dirty());
+}
+
+TEST_F(ObjectTree, dependency_graph)
+{
+  omm::Object& outline = add<omm::Outline>(root);
+  omm::Object& a = add(root);
+  omm::Object& b = add(a);
+  const auto position = [](const omm::DependencyGraph& graph, const omm::Object& object) {
+    const auto& order = graph.order();
+    return std::distance(order.begin(), std::find(order.begin(), order.end(), &object));
+  };
+
+  // the outline comes first in the hierarchy but depends on `b`.
+  auto* reference = outline.property(omm::Outline::REFERENCE_PROPERTY_KEY);
+  reference->set(static_cast<omm::AbstractPropertyOwner*>(&b));
+  const omm::DependencyGraph graph(root);
+  EXPECT_TRUE(graph.cyclic().empty());
+  EXPECT_LT(position(graph, b), position(graph, outline));
+  EXPECT_LT(position(graph, b), position(graph, a));
+  EXPECT_LT(position(graph, outline), position(graph, root));
+  EXPECT_FALSE(graph.is_stale());
+  graph.evaluate();
+
+  // only the downstream closure of `b` is updated.
+  b.set_transformation(omm::ObjectTransformation({ 1.0, 2.0 }, { 1.0, 1.0 }, 0.0, 0.0));
+  EXPECT_EQ(graph.evaluate(), 4u);
+  EXPECT_EQ(graph.evaluate(), 0u);
+
+  // referencing an ancestor closes a cycle.
+  reference->set(static_cast<omm::AbstractPropertyOwner*>(&root));
+  EXPECT_TRUE(graph.is_stale());
+  const omm::DependencyGraph cyclic_graph(root);
+  EXPECT_EQ(cyclic_graph.cyclic().size(), 2u);
+  EXPECT_EQ(cyclic_graph.order().size(), 4u);
+  reference->set(nullptr);
+}
+
+TEST_F(ObjectTree, parallel_evaluation)
+{
+  std::vector<omm::Object*> objects { &root };
+  for (std::size_t i = 0; i < 100; ++i) {
+    omm::Object& parent = add(root);
+    objects.push_back(&parent);
+    for (std::size_t j = 0; j < 3; ++j) {
+      objects.push_back(&add(parent));
+    }
+  }
+
+  omm::WorkStealingPool pool(4);
+  const omm::DependencyGraph graph(root);
+  EXPECT_EQ(graph.evaluate(pool), objects.size());
+  EXPECT_TRUE(std::none_of(objects.begin(), objects.end(), [](const omm::Object* object) {
+    return object->is_dirty();
+  }));
+  EXPECT_EQ(graph.evaluate(pool), 0u);
+
+  // a leaf, its parent and the root.
+  const omm::ObjectTransformation t({ 1.0, 0.0 }, { 1.0, 1.0 }, 0.0, 0.0);
+  objects.back()->set_transformation(t);
+  EXPECT_EQ(graph.evaluate(pool), 3u);
+
+  // objects which are not thread safe are updated on the calling thread. The results are the
+  // same as if everything was updated on the calling thread.
+  omm::Path parallel_root(&omm::test_scene());
+  omm::Path sequential_root(&omm::test_scene());
+  omm::RandomGeometry parallel_random;
+  omm::RandomGeometry sequential_random;
+  std::vector<Group> parallel_groups;
+  std::vector<Group> sequential_groups;
+  for (std::size_t i = 0; i < 20; ++i) {
+    parallel_groups.push_back(add_group(parallel_root, parallel_random));
+    sequential_groups.push_back(add_group(sequential_root, sequential_random));
+  }
+  omm::DependencyGraph(parallel_root).evaluate(pool);
+  omm::DependencyGraph(sequential_root).evaluate();
+  for (std::size_t i = 0; i < parallel_groups.size(); ++i) {
+    const Group& p = parallel_groups[i];
+    const Group& s = sequential_groups[i];
+    EXPECT_EQ(p.instance->thread, std::this_thread::get_id());
+    EXPECT_EQ(p.cloner->thread, std::this_thread::get_id());
+    EXPECT_EQ(p.outline->path_length(), s.outline->path_length());
+    EXPECT_EQ(p.outline->evaluate(0.5).position, s.outline->evaluate(0.5).position);
+    EXPECT_EQ(p.mirror->convert()->tree_child(0).points(),
+              s.mirror->convert()->tree_child(0).points());
+    EXPECT_EQ(p.instance->convert()->points(), s.instance->convert()->points());
+    EXPECT_EQ(p.cloner->convert()->n_children(), s.cloner->convert()->n_children());
+  }
+}
@@ -201,3 +201,27 @@ TEST(path, remove_add_points)
                                    omm::Point(omm::Vec2f(0, 3)),
                                    omm::Point(omm::Vec2f(0, 5)) } } });
 }
+
+TEST(path, update_cubics_in_place)
+{
+  omm::Path path(nullptr);
+  std::vector<omm::Point> points;
+  for (std::size_t i = 0; i < 10; ++i) {
+    points.push_back(omm::Point(omm::Vec2f(10.0 * i, 0.0)));
+  }
+  path.set_points(points);
+  const omm::Cubics* cubics = &path.cubics();
+  const auto clone = path.clone();
+  const auto& clone_cubics = static_cast<const omm::Path&>(*clone).cubics();
+  EXPECT_NE(&clone_cubics, cubics);
+
+  // the segments are updated in place, the clone keeps its geometry.
+  path.points_ref()[3]->position = omm::Vec2f(30.0, 50.0);
+  path.on_points_changed({ 3 }, {});
+  EXPECT_EQ(&path.cubics(), cubics);
+  const auto distance = [](const omm::Cubics& cubics, const omm::Vec2f& pos) {
+    return (cubics.segment(2).pos(1.0) - pos).euclidean_norm();
+  };
+  EXPECT_LE(distance(path.cubics(), omm::Vec2f(30.0, 50.0)), 10e-10);
+  EXPECT_LE(distance(clone_cubics, omm::Vec2f(30.0, 0.0)), 10e-10);
+}
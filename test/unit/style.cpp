@@ -0,0 +1,28 @@
+#include "gtest/gtest.h"
+#include "objects/path.h"
+#include "renderers/style.h"
+#include "tags/styletag.h"
+
+TEST(style, cache)
+{
+  omm::Style style;
+  EXPECT_EQ(style.pen().widthF(), 1.0);
+  const std::size_t revision = style.revision();
+  style.property(omm::Style::PEN_WIDTH_KEY)->set(2.0);
+  EXPECT_NE(style.revision(), revision);
+  EXPECT_EQ(style.pen().widthF(), 2.0);
+
+  omm::Path path(nullptr);
+  EXPECT_TRUE(path.find_styles().empty());
+  auto tag = std::make_unique<omm::StyleTag>(path);
+  auto& reference = *tag->property(omm::StyleTag::STYLE_REFERENCE_PROPERTY_KEY);
+  std::vector<std::unique_ptr<omm::Tag>> tags;
+  tags.push_back(std::move(tag));
+  path.tags.set(std::move(tags));
+  EXPECT_TRUE(path.find_styles().empty());
+
+  reference.set(static_cast<omm::AbstractPropertyOwner*>(&style));
+  EXPECT_EQ(path.find_styles(), std::vector<const omm::Style*>{ &style });
+  reference.set(static_cast<omm::AbstractPropertyOwner*>(nullptr));
+  EXPECT_TRUE(path.find_styles().empty());
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "python/pythonengine.h"
+#include "scene/scene.h"
+
+namespace omm
+{
+
+/**
+ * @brief returns the scene which is shared by all tests.
+ *  There is only one scene since the interpreter must not be initialized twice.
+ */
+inline Scene& test_scene()
+{
+  static PythonEngine python_engine;
+  static Scene scene(python_engine);
+  return scene;
+}
+
+}  // namespace omm